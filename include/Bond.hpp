@@ -1,25 +1,98 @@
 #pragma once
 #include "YieldCurve.hpp"
+#include <cstdint>
 #include <vector>
 #include <string>
+#include <utility>
 
 struct CashFlow {
     double amount;
     double time;
 };
 
+// Price and parallel-shift sensitivities from one pass over the schedule.
+// y is a parallel shift of the zero curve (continuous compounding).
+struct Sensitivities {
+    double price;
+    double pv01;             // dP/dy * 1bp: price change for a +1bp shift
+    double modifiedDuration; // -(1/P) dP/dy
+    double convexity;        // (1/P) d2P/dy2
+    double thirdDerivative;  // d3P/dy3, bounds the error of a second-order estimate
+};
+
 class Bond {
 protected:
+    std::string ticker; // Unique identifier
     double notional;
     double maturity;
 
+    // Payment schedule, generated once at construction (structure of arrays).
+    // Amount paid at cfTimes[i] = cfFixed[i] + cfAccrual[i] * rate(cfTimes[i]).
+    // cfAccrual holds notional * dt for floating coupons and is left empty
+    // for fixed-coupon instruments.
+    std::vector<double> cfTimes;
+    std::vector<double> cfFixed;
+    std::vector<double> cfAccrual;
+
+    // Last result, keyed on YieldCurve::getVersion(). Repeated pricing on an
+    // unchanged curve is free. Not synchronised: one instrument must not be
+    // priced from two threads at once.
+    mutable std::uint64_t cachedVersion = 0;
+    mutable Sensitivities cachedSensitivities{};
+
 public:
-    Bond(double n, double m);
+    Bond(std::string id, double n, double m);
     virtual ~Bond() = default;
 
-    virtual std::vector<CashFlow> getCashFlows(const YieldCurve& curve) const = 0;
+    // The virtual destructor would otherwise suppress the moves, turning
+    // every move of a value-type bond into a copy of its schedule
+    Bond(const Bond&) = default;
+    Bond(Bond&&) = default;
+    Bond& operator=(const Bond&) = default;
+    Bond& operator=(Bond&&) = default;
+
+    // Projected cash flows on the given curve (allocates; used for display).
+    // Pricing reads the cached schedule directly.
+    std::vector<CashFlow> getCashFlows(const YieldCurve& curve) const;
     
-    // Defined in .cpp or inline here if it's very short
-    double calculatePrice(const YieldCurve& curve) const; 
-    virtual std::string getName() const = 0;
+    // Both are memoised per curve version: the first call on a new curve
+    // computes price and sensitivities together in one schedule pass.
+    // Curve is any BasicYieldCurve instantiation; versions are unique
+    // across all of them, so one memo serves every interpolation.
+    template <class Curve>
+    double calculatePrice(const Curve& curve) const {
+        return calculateSensitivities(curve).price;
+    }
+
+    // Closed-form risk, no curve copy or repricing. Floating coupons move
+    // with the shift, so their projection term enters the derivatives.
+    template <class Curve>
+    Sensitivities calculateSensitivities(const Curve& curve) const {
+        if (curve.getVersion() != cachedVersion) {
+            cachedSensitivities = computeSensitivities(curve);
+            cachedVersion = curve.getVersion();
+        }
+        return cachedSensitivities;
+    }
+
+    // Uncached evaluation; safe to call concurrently on one instrument
+    template <class Curve>
+    Sensitivities computeSensitivities(const Curve& curve) const {
+        return hasFloatingCoupons() ? sweepSchedule<true>(curve) : sweepSchedule<false>(curve);
+    }
+
+    // The same pass with the coupon type fixed at compile time, for callers
+    // that already know it (see Instrument). Floating must equal hasFloatingCoupons().
+    template <bool Floating, class Curve>
+    Sensitivities sweepSchedule(const Curve& curve) const;
+
+    const std::string& getTicker() const { return ticker; }
+
+    // Read-only view of the cached schedule, for engines that flatten many bonds
+    const std::vector<double>& getCashFlowTimes() const { return cfTimes; }
+    const std::vector<double>& getFixedAmounts() const { return cfFixed; }
+    const std::vector<double>& getFloatingAccruals() const { return cfAccrual; }
+    bool hasFloatingCoupons() const { return !cfAccrual.empty(); }
+
+    virtual std::string getDescription() const = 0;
 };
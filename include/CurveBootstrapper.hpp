@@ -0,0 +1,74 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "YieldCurve.hpp"
+
+// A market instrument the zero curve is fitted to. Its maturity becomes a
+// pillar; what its quote means depends on the type:
+//   Deposit:    simple money-market rate q, DF(T) = 1 / (1 + q * T)
+//   ZeroCoupon: price per 100 notional (a ZeroCouponBond), DF(T) = q / 100
+//   ParBond:    par coupon rate of a VanillaBond paying `frequency` times a
+//               year, 1 = q / frequency * sum DF(coupon dates) + DF(T)
+struct CurveInstrument {
+    enum class Type : std::uint8_t { Deposit, ZeroCoupon, ParBond };
+
+    Type type;
+    double maturity; // Years
+    int frequency;   // Coupons per year (ParBond only)
+
+    static CurveInstrument deposit(double maturity) { return {Type::Deposit, maturity, 0}; }
+    static CurveInstrument zeroCoupon(double maturity) { return {Type::ZeroCoupon, maturity, 0}; }
+    static CurveInstrument parBond(double maturity, int frequency) {
+        return {Type::ParBond, maturity, frequency};
+    }
+};
+
+// Sequential bootstrap of the zero curve from a fixed instrument set.
+// Pillars are solved in maturity order, each reproducing its instrument
+// exactly on the curve's own linear-in-zero-rate interpolation. Coupon
+// dates before the previous pillar are already fixed, so a running sum of
+// their discount factors is kept per coupon frequency: a par bond only
+// solves for the dates in its own segment (one-dimensional Newton),
+// instead of repricing its whole schedule. Instruments are set once;
+// per-tick rebuilds take new quotes and reuse every buffer.
+class CurveBootstrapper {
+private:
+    // Coupon dates k / frequency and the running discount sum over them
+    struct CouponGrid {
+        int frequency;
+        std::vector<double> annuity; // annuity[k] = sum DF(j / frequency), j = 1..k
+        std::size_t segment = 0;     // Pillar segment of the last date added
+    };
+
+    std::vector<CurveInstrument> instruments; // Sorted by maturity
+    std::vector<std::size_t> quoteIndex;      // Position of each sorted instrument in the quote list
+    std::vector<std::size_t> gridOf;          // CouponGrid of each par bond
+    std::vector<CouponGrid> grids;
+    std::vector<double> times;
+    std::vector<double> rates;
+
+    // DF at t from the pillars solved so far (all of them cover t)
+    double solvedDiscountFactor(double t, std::size_t& segment, std::size_t solved) const;
+    void extendAnnuity(CouponGrid& grid, std::size_t count, std::size_t solved);
+    double solveParBond(std::size_t pillar, double coupon);
+
+public:
+    // Throws std::invalid_argument on an empty set, a non-positive maturity,
+    // two instruments with the same maturity, or a par bond without a
+    // positive frequency
+    explicit CurveBootstrapper(std::vector<CurveInstrument> instrumentSet);
+
+    // quotes[i] belongs to the i-th instrument as given to the constructor.
+    // If curve already has exactly these pillars (e.g. the last tick's
+    // result) only its rates are replaced and its pillar grid stays shared;
+    // otherwise it is rebuilt on them.
+    // Throws std::invalid_argument on a quote count mismatch and
+    // std::runtime_error if a quote implies no positive discount factor.
+    void bootstrap(const std::vector<double>& quotes, YieldCurve& curve);
+
+    YieldCurve bootstrap(const std::vector<double>& quotes);
+
+    // Pillar maturities, in increasing order
+    const std::vector<double>& getPillarTimes() const { return times; }
+};
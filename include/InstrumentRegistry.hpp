@@ -0,0 +1,34 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "Instruments.hpp"
+#include "TickerIndex.hpp"
+
+// Owns instruments by value in an arena of fixed-capacity chunks. A chunk
+// is reserved once and never grows past its capacity, so an instrument
+// never moves after add(): references and getBond() stay valid for the
+// registry's lifetime (moving the registry keeps the chunks' storage).
+// Instruments are addressed by dense InstrumentId handles in insertion
+// order, with no reference counting.
+class InstrumentRegistry {
+private:
+    static constexpr std::size_t CHUNK_SIZE = 1024;
+
+    std::vector<std::vector<Instrument>> chunks; // Each reserved to CHUNK_SIZE
+    std::vector<const Bond*> bonds;              // By id, pointing into the chunks
+
+public:
+    InstrumentRegistry() = default;
+    InstrumentRegistry(InstrumentRegistry&&) = default;
+    InstrumentRegistry& operator=(InstrumentRegistry&&) = default;
+    InstrumentRegistry(const InstrumentRegistry&) = delete;
+    InstrumentRegistry& operator=(const InstrumentRegistry&) = delete;
+
+    // Takes ownership and returns the instrument's id (the next dense id)
+    InstrumentId add(Instrument instrument);
+
+    std::size_t size() const { return bonds.size(); }
+
+    const Instrument& get(InstrumentId id) const { return chunks[id / CHUNK_SIZE][id % CHUNK_SIZE]; }
+    const Bond& getBond(InstrumentId id) const { return *bonds[id]; }
+};
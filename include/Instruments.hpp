@@ -1,31 +1,66 @@
 #pragma once
 #include "Bond.hpp"
+#include <type_traits>
+#include <variant>
 
-class VanillaBond : public Bond {
+// Cash flow schedules are generated in the constructors; the curve only
+// matters for projecting floating coupons at pricing time.
+
+class VanillaBond final : public Bond {
 private:
     double couponRate;
     int frequency;
 public:
-    VanillaBond(double n, double m, double c, int f);
-    std::vector<CashFlow> getCashFlows(const YieldCurve& curve) const override;
+    static constexpr bool FLOATING_COUPONS = false;
+
+    VanillaBond(std::string id, double n, double m, double c, int f);
     std::string getDescription() const override;
 };
 
-class ZeroCouponBond : public Bond {
+class ZeroCouponBond final : public Bond {
 public:
-    ZeroCouponBond(double n, double m);
-    std::vector<CashFlow> getCashFlows(const YieldCurve& curve) const override;
+    static constexpr bool FLOATING_COUPONS = false;
+
+    ZeroCouponBond(std::string id, double n, double m);
     std::string getDescription() const override;
     
 };
 
-class FloatingRateNote : public Bond {
+class FloatingRateNote final : public Bond {
 private:
     double spread;
     int frequency;
 
 public:
-    FloatingRateNote(double n, double m, double s, int f);
-    std::vector<CashFlow> getCashFlows(const YieldCurve &curve) const override;
+    static constexpr bool FLOATING_COUPONS = true;
+
+    FloatingRateNote(std::string id, double n, double m, double s, int f);
     std::string getDescription() const override;
 };
+
+// Value-type instrument: stored inline (no heap object per bond) and
+// dispatched by std::visit, so the concrete type is known at every call.
+// The classes above are final, which lets the compiler bind their
+// overrides directly inside a visitor.
+using Instrument = std::variant<VanillaBond, ZeroCouponBond, FloatingRateNote>;
+
+// Copy of a bond held through the base class.
+// Throws std::invalid_argument for a type outside the variant.
+Instrument toInstrument(const Bond& bond);
+
+inline const Bond& asBond(const Instrument& instrument) {
+    return std::visit([](const auto& bond) -> const Bond& { return bond; }, instrument);
+}
+
+inline std::string describe(const Instrument& instrument) {
+    return std::visit([](const auto& bond) { return bond.getDescription(); }, instrument);
+}
+
+// Uncached price and sensitivities, through the schedule pass specialised
+// for the instrument's coupon type
+inline Sensitivities computeSensitivities(const Instrument& instrument, const YieldCurve& curve) {
+    return std::visit([&curve](const auto& bond) {
+        using Type = std::decay_t<decltype(bond)>;
+        return bond.template sweepSchedule<Type::FLOATING_COUPONS>(curve);
+    }, instrument);
+}
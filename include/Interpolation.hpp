@@ -0,0 +1,56 @@
+#pragma once
+#include <cstddef>
+
+// Interpolation policies for BasicYieldCurve.
+// Inside a pillar segment [t_i, t_i+1] the zero rate is
+//   rate_i + offset(segment_i, t, t - t_i)
+// with the segment coefficients precomputed by build() whenever pillar
+// rates change. Coefficients depend only on rate differences, so a
+// parallel shift leaves them as they are. Outside the pillars the curve is
+// flat in the rate for every policy.
+//
+// build() fills segments [first, last) of a curve with pillarCount pillars.
+// A pillar's rate enters segments [pillar - REACH, pillar + REACH - 1], so
+// moving one pillar rebuilds only those.
+
+// Linear in zero rate
+struct LinearOnRate {
+    struct Segment {
+        double slope;
+    };
+    static constexpr std::size_t REACH = 1;
+
+    static void build(const double* times, const double* rates, std::size_t pillarCount,
+                      std::size_t first, std::size_t last, Segment* segments);
+
+    static double offset(const Segment& s, double, double dt) { return s.slope * dt; }
+};
+
+// Linear in log discount factor (-rate * t), i.e. flat forward rates
+// between pillars: rate(t) = rate_i + (rate_i+1 - rate_i) * t_i+1 / h * dt / t
+struct LogLinearOnDiscount {
+    struct Segment {
+        double scale; // (rate_i+1 - rate_i) * t_i+1 / (t_i+1 - t_i)
+    };
+    static constexpr std::size_t REACH = 1;
+
+    static void build(const double* times, const double* rates, std::size_t pillarCount,
+                      std::size_t first, std::size_t last, Segment* segments);
+
+    static double offset(const Segment& s, double t, double dt) { return s.scale * dt / t; }
+};
+
+// Monotone cubic Hermite in zero rate, with Fritsch-Butland tangents:
+// continuous first derivative, no overshoot between pillars, and each
+// tangent depends only on the neighbouring pillars
+struct MonotoneCubicOnRate {
+    struct Segment {
+        double b, c, d; // offset = b * dt + c * dt^2 + d * dt^3
+    };
+    static constexpr std::size_t REACH = 2;
+
+    static void build(const double* times, const double* rates, std::size_t pillarCount,
+                      std::size_t first, std::size_t last, Segment* segments);
+
+    static double offset(const Segment& s, double, double dt) { return dt * (s.b + dt * (s.c + dt * s.d)); }
+};
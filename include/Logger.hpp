@@ -0,0 +1,121 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+enum class LogLevel : std::uint8_t { Debug, Info, Warn, Error, Off };
+
+// What a record describes; decides how its fields are formatted
+enum class LogEvent : std::uint8_t {
+    Message,              // text
+    InstrumentRegistered, // text = ticker
+    TradeBooked,          // text = ticker; quantity, price, mid, edge captured
+    UnknownInstrument,    // id
+};
+
+// Fixed-size binary log record; formatting is deferred to the log thread
+struct LogRecord {
+    LogLevel level;
+    LogEvent event;
+    char text[46]; // Truncated, NUL-terminated
+    double values[4];
+};
+
+// Asynchronous structured logger.
+// Each producer thread writes records into its own single-producer ring, so
+// logging is a level check and a copy with no lock, formatting or I/O. A
+// background thread drains the rings, formats and writes in bulk (Warn and
+// above to the error stream) and flushes once per pass, then sleeps until a
+// producer wakes it. A full ring drops the record and counts it rather than
+// blocking. Records from one thread keep their order; different threads may
+// interleave. A thread's ring is freed once the thread has exited and the
+// ring has been drained.
+class Logger {
+private:
+    struct Ring {
+        std::unique_ptr<LogRecord[]> records;
+        std::size_t mask;
+        alignas(64) std::atomic<std::uint64_t> head{0}; // Written by the owner thread
+        alignas(64) std::atomic<std::uint64_t> tail{0}; // Read by the drainer
+        std::atomic<std::uint64_t> dropped{0};
+        std::atomic<bool> retired{false};  // Owner thread has exited
+        std::atomic<bool> orphaned{false}; // Logger destroyed
+
+        explicit Ring(std::size_t capacity);
+    };
+
+    // Rings a thread owns, one per logger it has written to; shared with the
+    // logger so either side may go first
+    struct ThreadRings;
+
+    // Per-thread cache of the ring for the logger last written to
+    static thread_local std::uint64_t cachedId;
+    static thread_local Ring* cachedRing;
+
+    std::atomic<LogLevel> level{LogLevel::Info};
+    std::size_t ringCapacity;
+    const std::uint64_t id; // Distinguishes loggers in the per-thread ring cache
+
+    mutable std::mutex drainMutex; // One drainer at a time; guards rings and sinks
+    std::vector<std::shared_ptr<Ring>> rings;
+    std::ostream* out;
+    std::ostream* err;
+    std::string outBuffer;
+    std::string errBuffer;
+
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    bool stopping = false;
+    std::atomic<bool> drainerIdle{false}; // Set while the drainer is going to sleep
+    std::thread drainer;
+
+    Ring* localRing(); // Null while the calling thread is exiting
+    void push(const LogRecord& record);
+    bool hasPending();
+    void drainLocked();
+    void format(const LogRecord& record, std::string& buffer) const;
+    void drainLoop();
+
+public:
+    // ringCapacity: records per producer thread (rounded up to a power of two)
+    explicit Logger(std::size_t ringCapacity = 4096);
+    ~Logger();
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    void setLevel(LogLevel minimum) { level.store(minimum, std::memory_order_relaxed); }
+    bool isEnabled(LogLevel l) const { return l >= level.load(std::memory_order_relaxed); }
+
+    // Where formatted records go (std::cout and std::cerr by default)
+    void setSinks(std::ostream& outStream, std::ostream& errStream);
+
+    void log(LogLevel l, LogEvent event, std::string_view text,
+             double v0 = 0.0, double v1 = 0.0, double v2 = 0.0, double v3 = 0.0) {
+        if (!isEnabled(l)) return;
+        LogRecord record{l, event, {}, {v0, v1, v2, v3}};
+        std::size_t n = text.size() < sizeof(record.text) - 1 ? text.size() : sizeof(record.text) - 1;
+        text.copy(record.text, n);
+        record.text[n] = '\0';
+        push(record);
+    }
+
+    // Writes everything logged before the call, from every thread, and
+    // flushes the sinks. Use before writing to the same stream directly.
+    void flush();
+
+    // Rings held: one per thread that has logged here and is still running,
+    // plus those of exited threads not yet drained
+    std::size_t getRingCount() const;
+
+    // Process-wide logger
+    static Logger& instance();
+};
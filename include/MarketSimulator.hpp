@@ -0,0 +1,79 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "Bond.hpp"
+#include "ThreadPool.hpp"
+#include "YieldCurve.hpp"
+
+struct SimulationConfig
+{
+    std::size_t paths = 10000;
+    std::size_t steps = 10;   // Client arrivals per path
+    std::uint64_t seed = 42;  // Path i draws from Philox stream (seed, i)
+
+    double riskAversion = 0.01;
+    double baseSpread = 0.10;
+    double curveVolBps = 5.0; // Std dev of the parallel curve move per step
+    double twistVolBps = 0.0; // Std dev of the twist per step (0: parallel moves only)
+    double twistPivot = 10.0; // Maturity the twist rotates around
+    double tradeSizeMean = 500.0;
+    double tradeSizeStdev = 200.0;
+};
+
+// End state of one simulated path
+struct PathResult
+{
+    double totalPnL;      // Cash from trades + final mark of the inventory
+    double spreadPnL;     // Edge captured against mid at each fill
+    double grossInventory; // Sum of |quantity| across instruments
+    double netPV01;       // Inventory PV01 on the final curve
+    std::size_t fills;
+};
+
+struct DistributionSummary
+{
+    double mean = 0.0;
+    double stdev = 0.0;
+    double min = 0.0;
+    double p01 = 0.0;
+    double p05 = 0.0;
+    double p50 = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+
+    static DistributionSummary of(std::vector<double> samples);
+};
+
+struct SimulationResult
+{
+    std::vector<PathResult> paths; // Indexed by path number
+    DistributionSummary totalPnL;
+    DistributionSummary spreadPnL;
+    DistributionSummary grossInventory;
+    DistributionSummary netPV01;
+};
+
+// Headless Monte Carlo of the market-making loop in main4: each path moves
+// the curve, draws client orders against the inventory-skewed quote
+// (TradingBook::computeQuote) and fills with probability exp(-|quote - mid|).
+// Paths run in parallel; each uses its own counter-based random stream and
+// writes to its own slot, so results do not depend on the thread count.
+class MarketSimulator
+{
+private:
+    std::vector<std::shared_ptr<Bond>> universe;
+    YieldCurve baseCurve;
+    ThreadPool& pool;
+
+    PathResult runPath(const SimulationConfig& config, std::uint64_t pathId,
+                       YieldCurve& curve, std::vector<double>& inventory) const;
+
+public:
+    MarketSimulator(std::vector<std::shared_ptr<Bond>> universe, const YieldCurve& curve,
+                    ThreadPool& pool = ThreadPool::instance());
+
+    SimulationResult run(const SimulationConfig& config) const;
+};
@@ -0,0 +1,76 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+// Philox4x32-10 counter-based generator (Salmon et al., SC'11).
+// Output block n of stream s is a pure function of (key, n, s), so every
+// simulation path gets its own reproducible stream regardless of which
+// thread runs it or in what order.
+class PhiloxStream {
+private:
+    std::uint32_t key[2];
+    std::uint64_t streamId;
+    std::uint64_t blockIndex = 0;
+    std::array<std::uint32_t, 4> block{};
+    unsigned used = 4; // Words of the current block already consumed
+
+    bool hasSpareNormal = false;
+    double spareNormal = 0.0;
+
+    static void round(std::array<std::uint32_t, 4>& ctr, const std::uint32_t k[2]) {
+        std::uint64_t p0 = static_cast<std::uint64_t>(0xD2511F53u) * ctr[0];
+        std::uint64_t p1 = static_cast<std::uint64_t>(0xCD9E8D57u) * ctr[2];
+        ctr = {static_cast<std::uint32_t>(p1 >> 32) ^ ctr[1] ^ k[0],
+               static_cast<std::uint32_t>(p1),
+               static_cast<std::uint32_t>(p0 >> 32) ^ ctr[3] ^ k[1],
+               static_cast<std::uint32_t>(p0)};
+    }
+
+    void refill() {
+        std::array<std::uint32_t, 4> ctr = {
+            static_cast<std::uint32_t>(blockIndex), static_cast<std::uint32_t>(blockIndex >> 32),
+            static_cast<std::uint32_t>(streamId), static_cast<std::uint32_t>(streamId >> 32)};
+        std::uint32_t k[2] = {key[0], key[1]};
+        for (int r = 0; r < 10; ++r) {
+            round(ctr, k);
+            k[0] += 0x9E3779B9u;
+            k[1] += 0xBB67AE85u;
+        }
+        block = ctr;
+        ++blockIndex;
+        used = 0;
+    }
+
+public:
+    PhiloxStream(std::uint64_t seed, std::uint64_t stream)
+        : key{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)},
+          streamId(stream) {}
+
+    std::uint32_t next() {
+        if (used == 4) refill();
+        return block[used++];
+    }
+
+    // Uniform on [0, 1) with 53 random bits
+    double uniform() {
+        std::uint64_t hi = next() >> 5;
+        std::uint64_t lo = next() >> 6;
+        return static_cast<double>((hi << 26) | lo) * (1.0 / 9007199254740992.0);
+    }
+
+    // Standard normal (Box-Muller, both variates used)
+    double normal() {
+        if (hasSpareNormal) {
+            hasSpareNormal = false;
+            return spareNormal;
+        }
+        double u1 = 1.0 - uniform(); // (0, 1]
+        double u2 = uniform();
+        double radius = std::sqrt(-2.0 * std::log(u1));
+        double angle = 6.283185307179586 * u2;
+        spareNormal = radius * std::sin(angle);
+        hasSpareNormal = true;
+        return radius * std::cos(angle);
+    }
+};
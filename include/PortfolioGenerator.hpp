@@ -0,0 +1,85 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "Instruments.hpp"
+#include "ThreadPool.hpp"
+
+// Relative weights of each instrument type in a generated universe
+struct PortfolioMix {
+    double vanilla = 1.0;
+    double floating = 1.0;
+    double zeroCoupon = 1.0;
+};
+
+// Terms of one generated bond, before it is built
+struct BondSpec {
+    enum class Type : std::uint8_t { Vanilla, Floating, ZeroCoupon };
+
+    Type type;
+    int maturity;      // Whole years, 2 to 30
+    double couponRate; // Vanilla coupon, or the FRN spread over the curve
+};
+
+// Generated instruments stored contiguously by type. Bonds never move once
+// built, so references and getBond() stay valid for the universe's lifetime.
+class InstrumentUniverse {
+private:
+    std::vector<VanillaBond> vanillaBonds;
+    std::vector<FloatingRateNote> floatingNotes;
+    std::vector<ZeroCouponBond> zeroCouponBonds;
+    std::vector<Bond*> bonds; // Generation order, pointing into the stores above
+
+    friend class PortfolioGenerator;
+
+public:
+    InstrumentUniverse() = default;
+    InstrumentUniverse(InstrumentUniverse&&) = default;
+    InstrumentUniverse& operator=(InstrumentUniverse&&) = default;
+    InstrumentUniverse(const InstrumentUniverse&) = delete;
+    InstrumentUniverse& operator=(const InstrumentUniverse&) = delete;
+
+    std::size_t size() const { return bonds.size(); }
+    Bond& getBond(std::size_t i) const { return *bonds[i]; }
+
+    const std::vector<VanillaBond>& getVanillaBonds() const { return vanillaBonds; }
+    const std::vector<FloatingRateNote>& getFloatingNotes() const { return floatingNotes; }
+    const std::vector<ZeroCouponBond>& getZeroCouponBonds() const { return zeroCouponBonds; }
+
+    // Shared handles to every bond, in generation order. The handles share
+    // ownership of the whole universe instead of allocating one per bond.
+    static std::vector<std::shared_ptr<Bond>> share(const std::shared_ptr<InstrumentUniverse>& universe);
+};
+
+// Reproducible random bond universes. Bond i is a pure function of
+// (seed, mix, i): it draws from its own counter-based random stream, so the
+// output does not depend on the thread count or on how many bonds are made,
+// and a smaller universe is always a prefix of a larger one.
+class PortfolioGenerator {
+private:
+    std::uint64_t seed;
+    double vanillaCutoff;  // Type draw below this: vanilla
+    double floatingCutoff; // Below this (and not vanilla): FRN; zero coupon otherwise
+
+public:
+    explicit PortfolioGenerator(std::uint64_t seed, const PortfolioMix& mix = {});
+
+    BondSpec describeBond(std::size_t index) const;
+
+    // Bond index of the universe on its own (ticker BOND_<index+1>_<m>Y...)
+    std::shared_ptr<Bond> generateBond(std::size_t index) const;
+
+    // The first count bonds, with terms drawn in parallel over the pool and
+    // built straight into reserved per-type storage
+    InstrumentUniverse generateUniverse(std::size_t count,
+                                        ThreadPool& pool = ThreadPool::instance()) const;
+
+    // Same bonds as values in generation order, for engines that visit
+    // instruments instead of calling through Bond
+    std::vector<Instrument> generateInstruments(std::size_t count,
+                                                ThreadPool& pool = ThreadPool::instance()) const;
+
+    // Same bonds as shared handles, for the components that hold shared_ptr
+    std::vector<std::shared_ptr<Bond>> generatePortfolio(std::size_t count) const;
+};
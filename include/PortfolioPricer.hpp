@@ -0,0 +1,83 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "Bond.hpp"
+#include "YieldCurve.hpp"
+
+class TradingBook;
+
+// Compiled view of a portfolio: every cash flow of every line flattened into
+// contiguous arrays, grouped by coupon type, so the whole book is priced in
+// one sweep per group instead of a virtual, allocating walk per bond.
+// Quantities and average costs are snapshotted at construction; rebuild
+// after the book changes. A pricer built from a book refers to the book's
+// instruments and must not outlive it.
+class PortfolioPricer {
+private:
+    // Cash flows of one instrument type, in line order
+    struct FlowGroup {
+        std::vector<double> times;
+        std::vector<double> fixed;
+        std::vector<double> accrual;     // Only filled for floating coupons
+        std::vector<std::uint32_t> line; // Owning line of each flow
+    };
+
+    std::vector<const Bond*> instruments;
+    std::vector<std::shared_ptr<Bond>> owned; // Keeps list-built lines alive
+    std::vector<double> quantities;
+    std::vector<double> averageCosts;
+
+    FlowGroup fixedFlows;    // Vanilla and zero coupon bonds
+    FlowGroup floatingFlows; // Floating rate notes
+
+    void addLine(const Bond& bond, double quantity, double averageCost);
+
+    // Accumulates flows [begin, end) of one group into per-line outputs
+    static void sweepFixed(const FlowGroup& group, const YieldCurve& curve, std::size_t begin,
+                           std::size_t end, double* prices, double* pv01s);
+    static void sweepFloating(const FlowGroup& group, const YieldCurve& curve, std::size_t begin,
+                              std::size_t end, double* prices, double* pv01s);
+
+public:
+    // Every non-flat position of the book
+    explicit PortfolioPricer(const TradingBook& book);
+
+    // A list of instruments, one unit each
+    explicit PortfolioPricer(const std::vector<std::shared_ptr<Bond>>& bonds);
+
+    std::size_t lineCount() const { return instruments.size(); }
+    std::size_t flowCount() const { return fixedFlows.times.size() + floatingFlows.times.size(); }
+    const Bond& getInstrument(std::size_t line) const { return *instruments[line]; }
+    double getQuantity(std::size_t line) const { return quantities[line]; }
+    double getAverageCost(std::size_t line) const { return averageCosts[line]; }
+
+    // Unit price (and unit PV01 unless pv01s is null) of lines [lineBegin, lineEnd),
+    // written at their line index. Disjoint ranges can be priced concurrently.
+    void priceLines(const YieldCurve& curve, std::size_t lineBegin, std::size_t lineEnd,
+                    double* prices, double* pv01s) const;
+
+    // Unit price of every line (prices is resized to lineCount())
+    void priceLines(const YieldCurve& curve, std::vector<double>& prices) const;
+
+    // Same sweep, also accumulating the unit PV01 of every line
+    void priceLines(const YieldCurve& curve, std::vector<double>& prices,
+                    std::vector<double>& pv01s) const;
+
+    // Unit key-rate PV01 of every line: row-major lineCount() x pillar count
+    void keyRatePV01(const YieldCurve& curve, std::vector<double>& lineKeyRates) const;
+
+    // Book key-rate PV01: sum of quantity * unit key-rate PV01, per pillar
+    std::vector<double> bookKeyRatePV01(const YieldCurve& curve) const;
+
+    // Position P&L of every line under every scenario, relative to the base
+    // curve: row-major lineCount() x scenarios.size(). One traversal of the
+    // cash flows; interpolation weights, base rates and discount factors are
+    // computed once per flow and the scenario loop runs inside it.
+    // Throws std::invalid_argument if a scenario does not have one entry per pillar.
+    void scenarioPnL(const YieldCurve& curve, const std::vector<CurveScenario>& scenarios,
+                     std::vector<double>& linePnL) const;
+
+    // Sum of quantity * unit price over all lines
+    double marketValue(const YieldCurve& curve) const;
+};
@@ -0,0 +1,47 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "ThreadPool.hpp"
+#include "TradingBook.hpp"
+
+// Everything needed to quote one instrument, on its own cache line
+struct alignas(64) QuoteState {
+    double mid = 0.0;       // Unit price on the last refreshed curve
+    double unitPV01 = 0.0;
+    double inventory = 0.0; // Book position, kept current by onFill
+};
+
+// Streams inventory-skewed quotes for every instrument in a book.
+// Mid and PV01 are recomputed only when the curve version changes; a quote
+// is then a read of one QuoteState and TradingBook::computeQuote, with no
+// allocation, lookup or pricing.
+class QuoteEngine {
+private:
+    const TradingBook& book;
+    ThreadPool& pool;
+    double baseSpread;
+
+    std::vector<QuoteState> states; // By InstrumentId
+    std::uint64_t quotedVersion = 0; // Curve version of the mids (0 = never)
+
+public:
+    QuoteEngine(const TradingBook& book, double baseSpread, ThreadPool& pool = ThreadPool::instance());
+
+    // Reprices mids and PV01s if the curve moved (in parallel), picks up
+    // newly registered instruments and reloads inventory from the book
+    void refresh(const YieldCurve& curve);
+
+    // Applies a fill booked since the last refresh to the quoting inventory
+    void onFill(const Trade& trade) { states[trade.instrument].inventory += trade.quantity; }
+
+    Quote quote(InstrumentId id) const {
+        const QuoteState& s = states[id];
+        return TradingBook::computeQuote(s.mid, s.unitPV01, s.inventory, baseSpread, book.getRiskAversion());
+    }
+
+    // Quotes for every instrument, out[id] for id < instrumentCount()
+    void quoteAll(Quote* out) const;
+
+    const QuoteState& getState(InstrumentId id) const { return states[id]; }
+    std::size_t instrumentCount() const { return states.size(); }
+};
@@ -2,15 +2,74 @@
 
 #include <vector>
 #include <memory>
-#include "Bond.hpp"       // Required to know what a 'Bond' is
+#include <string>
+#include "Instruments.hpp" // Required to know what a 'Bond' is
 #include "YieldCurve.hpp" // Required to know what a 'YieldCurve' is
+#include "ThreadPool.hpp"
+
+class PortfolioPricer;
+
+// A named curve scenario for stress testing, as per-pillar shifts in bps
+struct StressScenario {
+    std::string name;
+    CurveScenario pillarShiftsBps;
+
+    // Every pillar moves by bps
+    static StressScenario parallel(const YieldCurve& curve, double bps);
+
+    // Same shapes as YieldCurve::twist and YieldCurve::butterfly
+    static StressScenario twist(const YieldCurve& curve, double pivot, double bps);
+    static StressScenario butterfly(const YieldCurve& curve, double belly, double bps);
+
+    // Only pillar `index` moves
+    static StressScenario pillarBump(const YieldCurve& curve, std::size_t index, double bps);
+};
+
+// P&L of every position under every scenario
+struct StressGridResult {
+    std::vector<std::string> scenarioNames;
+    std::vector<double> linePnL;     // Row-major: line x scenario
+    std::vector<double> scenarioPnL; // Book total per scenario
+
+    double at(std::size_t line, std::size_t scenario) const {
+        return linePnL[line * scenarioNames.size() + scenario];
+    }
+};
 
 class RiskEngine {
 public:
     // Calculates the Price Value of a Basis Point (PV01)
     // Returns the change in price for a +1 basis point parallel shift
+    // (analytic first-order sensitivity, no curve copy)
     static double calculatePV01(const Bond& bond, const YieldCurve& baseCurve);
 
+    // Price, PV01, modified duration and convexity in a single pass
+    static Sensitivities calculateSensitivities(const Bond& bond, const YieldCurve& baseCurve);
+
+    // Uncached sensitivities of every instrument (out is resized to match),
+    // visited by concrete type and split across the pool
+    static void calculateSensitivities(const std::vector<Instrument>& instruments,
+                                       const YieldCurve& baseCurve, std::vector<Sensitivities>& out,
+                                       ThreadPool& pool = ThreadPool::instance());
+
+    // Key-rate PV01: price change for a +1bp bump of each curve pillar,
+    // in pillar order. Computed in one pass from each cash flow's
+    // interpolation weights; the buckets sum to the parallel PV01.
+    static std::vector<double> calculateKeyRatePV01(const Bond& bond, const YieldCurve& baseCurve);
+
+    // Adds scale * key-rate PV01 of n flows (accrual may be null for fixed
+    // coupons) into out[0 .. pillarCount). Shared by the single-bond and
+    // portfolio paths.
+    static void accumulateKeyRatePV01(const YieldCurve& curve, const double* times,
+                                      const double* fixed, const double* accrual,
+                                      std::size_t n, double scale, double* out);
+
+    // Evaluates a whole compiled portfolio across many scenarios in one
+    // cash flow traversal and returns the P&L matrix (nothing is printed)
+    static StressGridResult runStressGrid(const PortfolioPricer& portfolio,
+                                          const YieldCurve& baseCurve,
+                                          const std::vector<StressScenario>& scenarios);
+
     // Runs a scenario analysis on a full portfolio
     // Prints the P&L impact to the console
     static void runStressTest(const std::vector<std::unique_ptr<Bond>>& portfolio, 
@@ -0,0 +1,51 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "Instruments.hpp"
+#include "ThreadPool.hpp"
+#include "YieldCurve.hpp"
+
+// Outcome of one price-to-yield inversion
+struct SpreadResult {
+    double value = 0.0;     // Yield or spread, continuous compounding (0.01 = 100bp); NaN if unsolvable
+    int iterations = 0;
+    bool converged = false; // |model price - price| within tolerance
+};
+
+// Price -> yield inversion, the reverse of Bond::calculatePrice.
+//   Yield to maturity: the flat rate y with sum amount_i * exp(-y * t_i) = price.
+//   Z-spread: the constant s over the curve with sum amount_i * DF_i * exp(-s * t_i) = price.
+// Floating coupons are projected once on the curve and held fixed.
+// Each root is found by Newton's method on the analytic derivative,
+// safeguarded by the bracket the iterates build up (bisection whenever a
+// step leaves it, capped steps until it exists). Batches solve LANES bonds
+// at once: their flows are interleaved so one pass updates every lane, and
+// bonds are grouped by flow count to keep the padding small.
+class SpreadSolver {
+private:
+    ThreadPool& pool;
+    double tolerance;  // Relative to price
+    int maxIterations;
+
+    void solve(const std::vector<const Bond*>& bonds, const std::vector<double>& prices,
+               const YieldCurve& curve, bool overCurve, std::vector<SpreadResult>& out) const;
+
+public:
+    static constexpr std::size_t LANES = 4;
+
+    explicit SpreadSolver(ThreadPool& pool = ThreadPool::instance(), double tolerance = 1e-12,
+                          int maxIterations = 50);
+
+    SpreadResult yieldToMaturity(const Bond& bond, double price, const YieldCurve& curve) const;
+    SpreadResult zSpread(const Bond& bond, double price, const YieldCurve& curve) const;
+
+    // prices[i] belongs to bonds[i]; out is resized to match.
+    // Throws std::invalid_argument if the sizes differ.
+    // The solver reads only the cached schedules, which are the same for
+    // every instrument type, so value-type instruments are passed through
+    // asBond rather than visited.
+    void yieldsToMaturity(const std::vector<const Bond*>& bonds, const std::vector<double>& prices,
+                          const YieldCurve& curve, std::vector<SpreadResult>& out) const;
+    void zSpreads(const std::vector<const Bond*>& bonds, const std::vector<double>& prices,
+                  const YieldCurve& curve, std::vector<SpreadResult>& out) const;
+};
@@ -0,0 +1,52 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads running index-based parallel loops.
+// Tasks are claimed from a shared counter, so uneven chunks balance out;
+// the calling thread works alongside the pool until the loop completes.
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+    std::condition_variable wakeWorkers;
+    std::condition_variable jobDone;
+    std::mutex submitMutex; // One parallelFor at a time
+
+    // Current job
+    const std::function<void(std::size_t)>* task = nullptr;
+    std::size_t taskCount = 0;
+    std::atomic<std::size_t> nextTask{0};
+    std::size_t workersDone = 0; // Workers finished with the current job
+    std::size_t generation = 0;
+    std::exception_ptr firstError;
+    bool stopping = false;
+
+    void workerLoop();
+    void runTasks();
+
+public:
+    // threadCount includes the calling thread; 0 means hardware concurrency
+    explicit ThreadPool(std::size_t threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    std::size_t getThreadCount() const { return workers.size() + 1; }
+
+    // Runs fn(i) for every i in [0, count) and blocks until all are done.
+    // Rethrows the first exception thrown by a task. Nested calls from inside
+    // a task run serially on the calling thread.
+    void parallelFor(std::size_t count, const std::function<void(std::size_t)>& fn);
+
+    // Process-wide pool sized to the hardware
+    static ThreadPool& instance();
+};
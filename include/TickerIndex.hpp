@@ -0,0 +1,36 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Dense instrument identifier: 0, 1, 2, ... in registration order
+using InstrumentId = std::uint32_t;
+constexpr InstrumentId INVALID_INSTRUMENT = ~InstrumentId{0};
+
+// Interns tickers to InstrumentIds. Lookups go through an open-addressing
+// table (linear probing, at most half full) of ids and their hashes, so
+// finding a ticker is one hash, usually one probe and one string compare.
+class TickerIndex {
+private:
+    struct Slot {
+        std::uint64_t hash;
+        InstrumentId id; // INVALID_INSTRUMENT: empty
+    };
+
+    std::vector<Slot> slots;          // Power-of-two size
+    std::vector<std::string> tickers; // By id
+
+    static std::uint64_t hashOf(std::string_view ticker);
+    void rehash(std::size_t slotCount);
+
+public:
+    // Id of ticker, registering it if new
+    InstrumentId intern(std::string_view ticker);
+
+    // Id of ticker, or INVALID_INSTRUMENT if it was never registered
+    InstrumentId find(std::string_view ticker) const;
+
+    const std::string& getTicker(InstrumentId id) const { return tickers[id]; }
+    std::size_t size() const { return tickers.size(); }
+};
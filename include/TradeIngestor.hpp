@@ -0,0 +1,85 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "TradeQueue.hpp"
+#include "TradingBook.hpp"
+
+// Consistent view of one position
+struct PositionSnapshot {
+    double quantity = 0.0;
+    double averageCost = 0.0;
+    double realizedPnL = 0.0;
+};
+
+// Consistent view of the whole book after some number of applied fills
+struct BookSnapshot {
+    std::vector<PositionSnapshot> positions; // By InstrumentId
+    double realizedSpreadPnL = 0.0;
+    std::uint64_t tradesApplied = 0;
+};
+
+// Concurrent fill ingestion for a TradingBook.
+// Any number of feed threads submit fills into a lock-free TradeQueue; one
+// book thread drains it in batches through TradingBook::applyTrade, so the
+// book itself is only ever touched by that thread. After each batch the
+// lines it changed are published into a seqlock-protected mirror that
+// readers copy without blocking the writer.
+//
+// The book's instruments must all be registered before the ingestor is
+// constructed, and the book must not be used directly until stop().
+class TradeIngestor {
+private:
+    // Published position fields, atomics so readers may race the writer
+    struct SharedPosition {
+        std::atomic<double> quantity{0.0};
+        std::atomic<double> averageCost{0.0};
+        std::atomic<double> realizedPnL{0.0};
+    };
+
+    TradingBook& book;
+    TradeQueue queue;
+    std::size_t batchSize;
+
+    std::unique_ptr<SharedPosition[]> published; // By InstrumentId
+    std::size_t instrumentCount;
+    std::atomic<double> publishedSpreadPnL{0.0};
+    std::atomic<std::uint64_t> publishedTrades{0};
+    alignas(64) std::atomic<std::uint64_t> sequence{0}; // Odd while a publish is in progress
+
+    alignas(64) std::atomic<std::uint64_t> applied{0}; // Queue slots drained and applied, including rejected fills
+    std::atomic<std::uint64_t> rejected{0};            // Unknown instrument ids
+    std::atomic<bool> running{true};
+    std::thread writer;
+
+    void writerLoop();
+    void publish(const std::vector<InstrumentId>& touched, std::uint64_t tradesApplied);
+
+public:
+    explicit TradeIngestor(TradingBook& book, std::size_t queueCapacity = 1 << 16,
+                           std::size_t batchSize = 1024);
+    ~TradeIngestor();
+
+    TradeIngestor(const TradeIngestor&) = delete;
+    TradeIngestor& operator=(const TradeIngestor&) = delete;
+
+    // Any thread. Spins (yielding) while the queue is full.
+    void submit(const Trade& trade, double midPrice);
+    // Any thread. False, and nothing queued, if the queue is full.
+    bool trySubmit(const Trade& trade, double midPrice);
+
+    // Blocks until every fill submitted before the call has been applied
+    void flush();
+
+    // Drains what was submitted and stops the book thread. The book may be
+    // used directly again afterwards. Called by the destructor.
+    void stop();
+
+    // Readers, any thread. Retry only while a publish is in progress.
+    PositionSnapshot readPosition(InstrumentId id) const;
+    void snapshot(BookSnapshot& out) const;
+
+    std::uint64_t getRejectedCount() const { return rejected.load(std::memory_order_relaxed); }
+};
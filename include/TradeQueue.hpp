@@ -0,0 +1,49 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include "TradingBook.hpp"
+
+// A fill as it arrives from a venue
+struct TradeFill {
+    Trade trade;
+    double midPrice; // Mid at execution, for the edge captured
+};
+
+// Bounded lock-free multi-producer / single-consumer ring of fills
+// (Vyukov's sequenced-cell design). Each cell carries a sequence number
+// that tells producers and the consumer whose turn it is, so a push is one
+// CAS on the tail and a pop touches no shared counter at all.
+class TradeQueue {
+private:
+    struct alignas(64) Cell {
+        std::atomic<std::size_t> sequence;
+        TradeFill fill;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    std::size_t mask;
+
+    alignas(64) std::atomic<std::size_t> tail{0}; // Next slot to claim (producers)
+    alignas(64) std::size_t head = 0;             // Next slot to read (consumer only)
+
+public:
+    // capacity is rounded up to a power of two
+    explicit TradeQueue(std::size_t capacity);
+
+    TradeQueue(const TradeQueue&) = delete;
+    TradeQueue& operator=(const TradeQueue&) = delete;
+
+    // Any thread. False if the ring is full.
+    bool tryPush(const TradeFill& fill);
+
+    // Consumer thread only. False if the ring is empty.
+    bool tryPop(TradeFill& out);
+
+    // Any thread. Slots claimed by producers so far: every push that has
+    // returned true holds a slot below this, and the consumer pops slots in
+    // order, so once it has popped this many they have all been read
+    std::size_t claimed() const { return tail.load(std::memory_order_acquire); }
+
+    std::size_t capacity() const { return mask + 1; }
+};
@@ -1,11 +1,15 @@
 #pragma once
-#include <map>
+#include <cmath>
+#include <cstdint>
 #include <string>
+#include <vector>
 #include <memory>
 #include <iostream>
 #include "Bond.hpp"
 #include "YieldCurve.hpp"
 #include "RiskEngine.hpp"
+#include "TickerIndex.hpp"
+#include "InstrumentRegistry.hpp"
 
 // Asymmetric spread
 struct Quote
@@ -18,22 +22,53 @@ struct Quote
 // Represents a single transaction
 struct Trade
 {
-    std::string bondName;
+    InstrumentId instrument; // From TradingBook::addKnownInstrument
     double quantity; // Positive for BUY, Negative for SELL
     double price;    // Execution price (clean price)
 };
 
+// Running book-level risk totals
+struct BookRisk
+{
+    double marketValue = 0.0;
+    double unrealizedPnL = 0.0;
+    double pv01 = 0.0;
+};
+
+// Outcome of the last mark in fast-mark mode
+struct FastMarkStats
+{
+    std::size_t approximated = 0;   // Positions marked by Taylor expansion
+    std::size_t repriced = 0;       // Positions repriced exactly
+    double maxEstimatedError = 0.0; // Largest estimated unit price error accepted
+};
+
 // Represents our current holding in a specific bond
 class Position
 {
 public:
-    std::shared_ptr<Bond> instrument;
+    const Bond* instrument; // Owned by the book's InstrumentRegistry
     double quantity;    // Face Value of Current holdings
     double averageCost; // VWAP
     double realizedPnL; // Cash banked from closing positions
 
-    Position(std::shared_ptr<Bond> bond)
-        : instrument(bond), quantity(0), averageCost(0), realizedPnL(0) {}
+    // Unit metrics cached by TradingBook at the last curve it was marked on
+    double unitPrice = 0.0;
+    double unitPV01 = 0.0;
+
+    // Fast-mark base: exact unit sensitivities at the last exact reprice,
+    // and where that curve sits in its parallel-shift lineage
+    Sensitivities baseSensitivities{};
+    std::uint64_t baseAnchorVersion = 0;
+    double baseShiftBps = 0.0;
+
+    explicit Position(const Bond& bond)
+        : instrument(&bond), quantity(0), averageCost(0), realizedPnL(0) {}
+
+    // This position's share of the book totals, from the cached unit metrics
+    BookRisk getCachedRisk() const {
+        return {quantity * unitPrice, (unitPrice - averageCost) * quantity, quantity * unitPV01};
+    }
 
     void addTrade(const Trade &trade);
 
@@ -43,6 +78,9 @@ public:
     // Position Risk = PV01 (per unit) * Quantity
     double getTotalPV01(const YieldCurve &market) const;
 
+    // Key-rate risk = key-rate PV01 (per unit) * Quantity, one entry per curve pillar
+    std::vector<double> getKeyRatePV01(const YieldCurve &market) const;
+
     // Unrealized P&L = (Current Price - Cost) * Quantity
     double getUnrealizedPnL(const YieldCurve &market) const;
 };
@@ -51,40 +89,81 @@ public:
 class TradingBook
 {
 private:
-    // Map Bond Name -> Position Object
-    std::map<std::string, Position> positions;
+    // Tickers interned to dense ids; instruments and positions are both
+    // indexed by id, so trades and lookups by id are a vector index
+    TickerIndex tickerIndex;
+    InstrumentRegistry instruments;
+    std::vector<Position> positions;
     double realizedSpreadPnL = 0; // Spread profit from market-making
     double riskAversion = 0.01;
 
+    // Book totals, kept up to date trade by trade from the cached unit
+    // metrics and recomputed in full only when the curve changes
+    BookRisk bookRisk;
+    std::uint64_t markedVersion = 0; // Curve version of the cached unit metrics (0 = never)
+
+    bool fastMark = false;
+    double fastMarkTolerance = 1e-4;
+    FastMarkStats fastMarkStats;
+
+    void remarkAll(const YieldCurve& market);
+
 public:
-    // Helper to register a bond in the system (Reference Data)
-    void addKnownInstrument(std::shared_ptr<Bond> bond);
+    // Helper to register a bond in the system (Reference Data); the book
+    // takes ownership. Returns its id (the existing one if the ticker is
+    // already known, in which case the instrument is discarded).
+    InstrumentId addKnownInstrument(Instrument instrument);
+
+    // Registers a copy of the bond; the book does not keep the handle
+    InstrumentId addKnownInstrument(const std::shared_ptr<Bond>& bond);
+
+    // A registered instrument (id must be valid); stays put while the book lives
+    const Bond& getInstrument(InstrumentId id) const { return instruments.getBond(id); }
+    const InstrumentRegistry& getInstruments() const { return instruments; }
+
+    // Id of a registered ticker, or INVALID_INSTRUMENT
+    InstrumentId getInstrumentId(const std::string& ticker) const { return tickerIndex.find(ticker); }
 
     // Execute a trade
     void bookTrade(const Trade& trade, double midPrice);
 
+    // The accounting part of bookTrade, without the trade log: updates the
+    // position, spread P&L and book totals and returns the edge captured.
+    // trade.instrument must be a registered id.
+    double applyTrade(const Trade& trade, double midPrice);
+
     std::pair<double, double> getBidAsk(const Bond& bond, const YieldCurve& market) const {
         double mid = bond.calculatePrice(market);
         double halfSpread = 0.05; // spread fixed at 0.5 per 100 face value
         return {mid - halfSpread, mid + halfSpread};
     }
 
-    double getPosition(const std::string& ticker) const;
+    double getPosition(InstrumentId id) const {
+        return id < positions.size() ? positions[id].quantity : 0.0;
+    }
+    double getPosition(const std::string& ticker) const { return getPosition(getInstrumentId(ticker)); }
 
     double getSpreadPnL() const { return realizedSpreadPnL; }
+    double getRiskAversion() const { return riskAversion; }
 
+    // Indexed by InstrumentId, in registration order
+    const std::vector<Position>& getPositions() const { return positions; }
+
+    Quote getQuotedSpread(InstrumentId id, double midPrice, double unitPV01, double baseSpread) const {
+        // 1. Check current inventory
+        return computeQuote(midPrice, unitPV01, getPosition(id), baseSpread, riskAversion);
+    }
     Quote getQuotedSpread(const std::string& ticker, double midPrice, double unitPV01, double baseSpread) const {
-        double currentInventory = 0.0;
-        double riskMagnitude = std::abs(unitPV01);
+        return getQuotedSpread(getInstrumentId(ticker), midPrice, unitPV01, baseSpread);
+    }
 
-        // 1. Check current invetory
-        auto it = positions.find(ticker);
-        if (it != positions.end()) {
-            currentInventory = it->second.quantity;
-        }
+    // Inventory-skewed two-way quote, shared with the simulator
+    static Quote computeQuote(double midPrice, double unitPV01, double inventory,
+                              double baseSpread, double riskAversion) {
+        double riskMagnitude = std::abs(unitPV01);
 
         // 2. Calculate Skew (-1 * aversion * inventory * bond risk)
-        double rawSkew = -1.0 * riskAversion * currentInventory * riskMagnitude;
+        double rawSkew = -1.0 * riskAversion * inventory * riskMagnitude;
 
         double maxSkew = baseSpread * 1.5;
 
@@ -103,6 +182,26 @@ public:
         };
     }
 
+    // Book PV01 bucketed by curve pillar (sums to the total book PV01)
+    std::vector<double> getKeyRatePV01(const YieldCurve &market) const;
+
+    // Refresh cached unit metrics and book totals; no-op if the curve version is unchanged
+    void markToMarket(const YieldCurve& market);
+
+    // Fast-mark mode: when the curve has only moved in parallel since a
+    // position was last repriced, estimate its price and PV01 from the cached
+    // price, PV01 and convexity (second-order Taylor in the shift). The third
+    // order term estimates the error; any position whose estimated unit price
+    // error exceeds tolerance is repriced exactly and becomes the new base.
+    void setFastMark(bool enabled, double tolerance = 1e-4);
+    const FastMarkStats& getFastMarkStats() const { return fastMarkStats; }
+
+    // Book totals on the given curve (incremental unless the curve moved)
+    const BookRisk& getBookRisk(const YieldCurve& market);
+
     // Market Maker Report
-    void printRiskReport(const YieldCurve &market) const;
+    void printRiskReport(const YieldCurve &market);
+
+    // Key-rate PV01 per pillar for every position, plus the book total
+    void printKeyRateReport(const YieldCurve &market) const;
 };
\ No newline at end of file
@@ -0,0 +1,58 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "PortfolioPricer.hpp"
+#include "ThreadPool.hpp"
+#include "YieldCurve.hpp"
+
+class TradingBook;
+
+struct VaRResult
+{
+    double confidence = 0.0;
+    double valueAtRisk = 0.0;       // Loss not exceeded with probability `confidence`
+    double expectedShortfall = 0.0; // Average loss in the tail beyond VaR
+    std::vector<double> scenarioPnL; // Book P&L per scenario, in scenario order
+};
+
+// Historical and Monte Carlo Value-at-Risk / Expected Shortfall.
+// The book is compiled once into a PortfolioPricer; scenarios are split into
+// batches across the thread pool and each scenario is one vectorised sweep
+// over the flattened cash flows on the shocked curve.
+class VaREngine
+{
+private:
+    ThreadPool& pool;
+    std::size_t batchSize;
+
+public:
+    explicit VaREngine(ThreadPool& pool = ThreadPool::instance(), std::size_t batchSize = 64);
+
+    // Full revaluation P&L of the portfolio under every scenario
+    std::vector<double> scenarioPnL(const PortfolioPricer& portfolio, const YieldCurve& baseCurve,
+                                    const std::vector<CurveScenario>& scenarios) const;
+
+    VaRResult compute(const PortfolioPricer& portfolio, const YieldCurve& baseCurve,
+                      const std::vector<CurveScenario>& scenarios, double confidence) const;
+
+    VaRResult compute(const TradingBook& book, const YieldCurve& baseCurve,
+                      const std::vector<CurveScenario>& scenarios, double confidence) const;
+
+    // VaR and ES of a P&L sample (losses are reported as positive numbers)
+    static VaRResult fromPnL(std::vector<double> pnl, double confidence);
+
+    // Historical pillar changes: one scenario per line, comma separated bps,
+    // one column per pillar. Blank lines and lines starting with '#' are
+    // skipped. Throws std::runtime_error on unreadable or malformed input.
+    static std::vector<CurveScenario> loadHistoricalScenarios(const std::string& path,
+                                                              std::size_t pillarCount);
+
+    // Correlated normal pillar shocks: shock = L * z * vol, with L the Cholesky
+    // factor of `correlation`. Scenario i draws from Philox stream (seed, i).
+    // Throws std::invalid_argument if the matrix is not positive definite.
+    static std::vector<CurveScenario> simulateScenarios(const std::vector<double>& volsBps,
+                                                        const std::vector<std::vector<double>>& correlation,
+                                                        std::size_t count, std::uint64_t seed);
+};
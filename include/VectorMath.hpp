@@ -0,0 +1,7 @@
+#pragma once
+#include <cstddef>
+
+// x[i] = exp(x[i]) over a contiguous block. With ENABLE_AVX2 the bulk runs
+// through a four-lane AVX2/FMA kernel (within 1-2 ulp of std::exp, arguments
+// clamped to +/-708); the tail and non-AVX2 builds use std::exp.
+void expInPlace(double* x, std::size_t n);
@@ -1,14 +1,166 @@
 #pragma once
-#include <map>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
 #include <vector>
+#include "Interpolation.hpp"
 
-class YieldCurve {
+// A curve scenario: change of each pillar rate in basis points, in pillar order
+using CurveScenario = std::vector<double>;
+
+// Curve epoch counter, shared by every interpolation policy so versions of
+// different curve types never collide
+std::uint64_t nextCurveVersion();
+
+// Zero curve stored as contiguous sorted pillar arrays.
+// Each segment [times[i], times[i+1]] keeps its precomputed interpolation
+// coefficients, and a uniform grid over [times.front(), times.back()] maps
+// any t to its segment in constant time, so lookups never walk a tree.
+// Copies share the pillar grid; only the rates and coefficients are per
+// curve. The interpolation is a compile-time policy (see Interpolation.hpp),
+// so every lookup path is specialised for it with no runtime dispatch.
+// Instantiated for the three policies in Interpolation.hpp; YieldCurve is
+// the linear-in-rate curve used throughout.
+template <class Interpolation>
+class BasicYieldCurve {
 private:
-    std::map<double, double> rates; 
+    // Pillar maturities and their bucket index. Immutable once built and
+    // shared between a curve and its copies and shocked versions, so moving
+    // rates never copies or rebuilds the time axis.
+    struct PillarGrid {
+        std::vector<double> times; // Strictly increasing
+
+        // Uniform bucket index: bucket k holds the last segment whose start
+        // pillar falls in an earlier bucket, so it never overshoots any t in k.
+        std::vector<std::size_t> index;
+        double start = 0.0;
+        double scale = 0.0; // Buckets per year
+
+        void rebuildIndex();
+
+        std::size_t bucketOf(double t) const {
+            return static_cast<std::size_t>((t - start) * scale);
+        }
+    };
+
+    std::shared_ptr<const PillarGrid> grid;
+    using Segment = typename Interpolation::Segment;
+
+    std::vector<double> rates;     // Zero rate at each pillar
+    std::vector<Segment> segments; // Coefficients of [times[i], times[i+1]]
+
+    // Epoch of the curve contents. Drawn from a process-wide counter on
+    // construction and on every mutation, so equal versions mean equal
+    // curves (copies share their source's version until they are modified).
+    std::uint64_t version;
+
+    // Parallel-shift lineage: the curve equals the one at anchorVersion
+    // shifted by shiftFromAnchorBps. Reset by any non-parallel change.
+    std::uint64_t anchorVersion;
+    double shiftFromAnchorBps = 0.0;
+
+    void rebuildSegments();
+    void rebuildSegmentsAround(std::size_t pillar);
+
+    // New version, and a new anchor: the change was not a parallel shift
+    void markReshaped();
+
+    // Index i of the segment with times[i] <= t < times[i+1].
+    // Requires times.front() < t < times.back(). Every lookup path resolves
+    // a t to the same segment, so single and batch results are identical.
+    std::size_t findSegment(double t) const {
+        const std::vector<double>& times = grid->times;
+        std::size_t i = grid->index[grid->bucketOf(t)];
+        while (t >= times[i + 1]) ++i;
+        return i;
+    }
 
 public:
+    BasicYieldCurve()
+        : grid(std::make_shared<PillarGrid>()), version(nextCurveVersion()), anchorVersion(version) {}
+
     void addRate(double time, double rate);
     double getRate(double t) const;
     double getDiscountFactor(double t) const;
+
+    // Batch lookups over n maturities: out[i] = getRate(t[i]) and
+    // out[i] = getDiscountFactor(t[i]). The segment search is carried from one
+    // maturity to the next, so sorted input (cash flow order) is walked in a
+    // single merged pass; unsorted input is still valid.
+    void getRates(const double* t, double* out, std::size_t n) const;
+    void getDiscountFactors(const double* t, double* out, std::size_t n) const;
+    // Both at once, for floating coupons projected off the same rates
+    void getRatesAndDiscountFactors(const double* t, double* rateOut, double* dfOut,
+                                    std::size_t n) const;
+
+    // Bumped by every mutation; never 0
+    std::uint64_t getVersion() const { return version; }
+
+    // Curves with the same anchor differ only by a parallel shift, equal to
+    // the difference of their getShiftFromAnchor() (in basis points)
+    std::uint64_t getAnchorVersion() const { return anchorVersion; }
+    double getShiftFromAnchor() const { return shiftFromAnchorBps; }
+
+    // Pillars, in increasing maturity
+    std::size_t getPillarCount() const { return grid->times.size(); }
+    const std::vector<double>& getPillarTimes() const { return grid->times; }
+
+    // Key-rate bucketing of each maturity: the share w[i] of pillar
+    // left[i] + 1 and 1 - w[i] of pillar left[i], linear in time between
+    // them. w is 0 on the flat extrapolated ends, where only pillar left[i]
+    // matters. This is exactly how getRate(t[i]) depends on the pillar rates
+    // only when the rate is linear in time, so it exists for LinearOnRate
+    // alone: log-linear rates weight the pillars by t_i / t, and a monotone
+    // cubic rate depends nonlinearly on four pillars. The key-rate and
+    // scenario engines therefore take the linear YieldCurve. Same merged walk
+    // as getRates.
+    template <class I = Interpolation,
+              class = std::enable_if_t<std::is_same<I, LinearOnRate>::value>>
+    void getPillarWeights(const double* t, std::size_t* left, double* w, std::size_t n) const;
+
+    // Curve shocks, all in basis points. Each moves the pillar rates only;
+    // the pillar grid is left as is (and stays shared with any copies).
     void parallelShift(double basisPoints);
-};
\ No newline at end of file
+
+    // Moves pillar index alone; only the segments it reaches are rebuilt
+    void bumpPillar(std::size_t index, double basisPoints);
+
+    // Rotation around pivot: the last pillar moves by +basisPoints, the first
+    // by -basisPoints, linear in maturity on each side (steepener for > 0)
+    void twist(double pivot, double basisPoints);
+
+    // Wings (first and last pillar) move by +basisPoints and the belly by
+    // -basisPoints, linear in maturity in between
+    void butterfly(double belly, double basisPoints);
+
+    // Moves pillar i by basisPoints[i] (one entry per pillar, in pillar order)
+    void shiftPillars(const CurveScenario& basisPoints);
+
+    // Replaces every pillar rate (one per pillar, in pillar order), keeping
+    // the pillar grid shared with any copies
+    void setRates(const std::vector<double>& pillarRates);
+
+    // The per-pillar shifts twist() and butterfly() apply
+    CurveScenario twistShifts(double pivot, double basisPoints) const;
+    CurveScenario butterflyShifts(double belly, double basisPoints) const;
+
+    // Makes this curve base shifted by basisPoints (one entry per pillar).
+    // Shares base's pillar grid and reuses this curve's rate buffers, so a
+    // scratch curve can be re-shocked per scenario without allocating.
+    void assignShocked(const BasicYieldCurve& base, const CurveScenario& basisPoints);
+
+    // Same pillars and rates (the derived index and coefficients follow from them)
+    bool operator==(const BasicYieldCurve& other) const {
+        return (grid == other.grid || grid->times == other.grid->times) && rates == other.rates;
+    }
+    bool operator!=(const BasicYieldCurve& other) const { return !(*this == other); }
+};
+
+extern template class BasicYieldCurve<LinearOnRate>;
+extern template class BasicYieldCurve<LogLinearOnDiscount>;
+extern template class BasicYieldCurve<MonotoneCubicOnRate>;
+
+using YieldCurve = BasicYieldCurve<LinearOnRate>;
+using LogLinearYieldCurve = BasicYieldCurve<LogLinearOnDiscount>;
+using MonotoneCubicYieldCurve = BasicYieldCurve<MonotoneCubicOnRate>;
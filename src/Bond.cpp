@@ -1,29 +1,80 @@
-#pragma once
-#include "YieldCurve.hpp"
-#include <vector>
-#include <string>
-
-struct CashFlow {
-    double amount;
-    double time;
-};
-
-class Bond {
-protected:
-    std::string ticker; // Unique identifier
-    double notional;
-    double maturity;
-
-public:
-    Bond(std::string id, double n, double m);
-    virtual ~Bond() = default;
-
-    virtual std::vector<CashFlow> getCashFlows(const YieldCurve& curve) const = 0;
-    
-    // Defined in .cpp or inline here if it's very short
-    double calculatePrice(const YieldCurve& curve) const;
-
-    std::string getTicker() const { return ticker; }
-
-    virtual std::string getDescription() const = 0;
-};
+#include "Bond.hpp"
+#include <algorithm>
+
+namespace {
+    // Cash flows are discounted in fixed-size stack blocks through the batch
+    // curve API, so pricing never allocates
+    constexpr std::size_t BLOCK = 64;
+}
+
+Bond::Bond(std::string id, double n, double m)
+    : ticker(std::move(id)), notional(n), maturity(m) {}
+
+std::vector<CashFlow> Bond::getCashFlows(const YieldCurve& curve) const {
+    std::vector<CashFlow> flows;
+    flows.reserve(cfTimes.size());
+    for (std::size_t i = 0; i < cfTimes.size(); ++i) {
+        double amount = cfFixed[i];
+        if (!cfAccrual.empty()) amount += cfAccrual[i] * curve.getRate(cfTimes[i]);
+        flows.push_back({amount, cfTimes[i]});
+    }
+    return flows;
+}
+
+template <bool Floating, class Curve>
+Sensitivities Bond::sweepSchedule(const Curve& curve) const {
+    double dfs[BLOCK];
+
+    // With amount = F + A*(r + y) and DF = exp(-(r + y) * t):
+    //   dP/dy   = sum (A - t * amount) * DF
+    //   d2P/dy2 = sum (t^2 * amount - 2 * A * t) * DF
+    //   d3P/dy3 = sum (3 * A * t^2 - t^3 * amount) * DF
+    double price = 0.0;
+    double dPdy = 0.0;
+    double d2Pdy2 = 0.0;
+    double d3Pdy3 = 0.0;
+    for (std::size_t start = 0; start < cfTimes.size(); start += BLOCK) {
+        std::size_t n = std::min(BLOCK, cfTimes.size() - start);
+        const double* times = cfTimes.data() + start;
+        const double* fixed = cfFixed.data() + start;
+
+        if constexpr (!Floating) {
+            curve.getDiscountFactors(times, dfs, n);
+            for (std::size_t i = 0; i < n; ++i) {
+                double pv = fixed[i] * dfs[i];
+                price += pv;
+                double t2 = times[i] * times[i];
+                dPdy -= times[i] * pv;
+                d2Pdy2 += t2 * pv;
+                d3Pdy3 -= t2 * times[i] * pv;
+            }
+        } else {
+            const double* accrual = cfAccrual.data() + start;
+            double rates[BLOCK];
+            curve.getRatesAndDiscountFactors(times, rates, dfs, n);
+            for (std::size_t i = 0; i < n; ++i) {
+                double pv = (fixed[i] + accrual[i] * rates[i]) * dfs[i];
+                double accrualPv = accrual[i] * dfs[i];
+                price += pv;
+                double t2 = times[i] * times[i];
+                dPdy += accrualPv - times[i] * pv;
+                d2Pdy2 += t2 * pv - 2.0 * times[i] * accrualPv;
+                d3Pdy3 += 3.0 * t2 * accrualPv - t2 * times[i] * pv;
+            }
+        }
+    }
+
+    Sensitivities s{price, dPdy * 1e-4, 0.0, 0.0, d3Pdy3};
+    if (price != 0.0) {
+        s.modifiedDuration = -dPdy / price;
+        s.convexity = d2Pdy2 / price;
+    }
+    return s;
+}
+
+template Sensitivities Bond::sweepSchedule<false>(const YieldCurve& curve) const;
+template Sensitivities Bond::sweepSchedule<true>(const YieldCurve& curve) const;
+template Sensitivities Bond::sweepSchedule<false>(const LogLinearYieldCurve& curve) const;
+template Sensitivities Bond::sweepSchedule<true>(const LogLinearYieldCurve& curve) const;
+template Sensitivities Bond::sweepSchedule<false>(const MonotoneCubicYieldCurve& curve) const;
+template Sensitivities Bond::sweepSchedule<true>(const MonotoneCubicYieldCurve& curve) const;
@@ -0,0 +1,51 @@
+// Analytic parallel-shift sensitivities against central finite differences
+// of the bond price on shifted curves
+#include "Instruments.hpp"
+#include "TestSupport.hpp"
+#include <memory>
+#include <vector>
+
+namespace {
+    constexpr double BUMP_BPS = 1.0; // Finite-difference step
+
+    double priceShifted(const Bond& bond, const YieldCurve& curve, double bps) {
+        YieldCurve shifted = curve;
+        shifted.parallelShift(bps);
+        return bond.calculatePrice(shifted);
+    }
+}
+
+int main() {
+    YieldCurve curve = makeTestCurve();
+
+    std::vector<std::unique_ptr<Bond>> bonds;
+    bonds.push_back(std::make_unique<VanillaBond>("VANILLA_30Y", 100.0, 30.0, 0.05, 2));
+    bonds.push_back(std::make_unique<ZeroCouponBond>("ZERO_10Y", 100.0, 10.0));
+    bonds.push_back(std::make_unique<FloatingRateNote>("FRN_20Y", 100.0, 20.0, 0.004, 4));
+
+    const double h = BUMP_BPS * 1e-4;
+    for (const auto& bond : bonds) {
+        const std::string& name = bond->getTicker();
+        Sensitivities s = bond->calculateSensitivities(curve);
+
+        double p0 = bond->calculatePrice(curve);
+        double up = priceShifted(*bond, curve, BUMP_BPS);
+        double down = priceShifted(*bond, curve, -BUMP_BPS);
+        double up2 = priceShifted(*bond, curve, 2.0 * BUMP_BPS);
+        double down2 = priceShifted(*bond, curve, -2.0 * BUMP_BPS);
+
+        // Five-point stencils, so the O(h^4) truncation error does not
+        // swamp the small PV01 of a floater
+        double d1 = (8.0 * (up - down) - (up2 - down2)) / (12.0 * h);
+        double d2 = (16.0 * (up + down) - (up2 + down2) - 30.0 * p0) / (12.0 * h * h);
+        double d3 = (up2 - 2.0 * up + 2.0 * down - down2) / (2.0 * h * h * h);
+
+        expectRelative(name + " price", s.price, p0, 1e-14);
+        expectRelative(name + " PV01", s.pv01, d1 * 1e-4, 1e-8);
+        expectRelative(name + " modified duration", s.modifiedDuration, -d1 / p0, 1e-8);
+        expectRelative(name + " convexity", s.convexity, d2 / p0, 1e-6);
+        expectRelative(name + " third derivative", s.thirdDerivative, d3, 1e-4);
+    }
+
+    return testResult("Bond sensitivities match finite differences");
+}
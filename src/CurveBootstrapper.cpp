@@ -0,0 +1,175 @@
+#include "CurveBootstrapper.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+namespace {
+    constexpr int MAX_NEWTON_STEPS = 50;
+    constexpr double RATE_TOLERANCE = 1e-15;
+    constexpr double DATE_EPSILON = 1e-9; // Coupon periods are compared as k / frequency
+
+    // Number of coupon dates k / frequency no later than t
+    std::size_t datesUpTo(double t, int frequency) {
+        return static_cast<std::size_t>(std::floor(t * frequency + DATE_EPSILON));
+    }
+}
+
+CurveBootstrapper::CurveBootstrapper(std::vector<CurveInstrument> instrumentSet) {
+    if (instrumentSet.empty()) {
+        throw std::invalid_argument("CurveBootstrapper: no instruments");
+    }
+
+    // 1. Pillar order, remembering where each instrument's quote comes from
+    quoteIndex.resize(instrumentSet.size());
+    std::iota(quoteIndex.begin(), quoteIndex.end(), 0);
+    std::sort(quoteIndex.begin(), quoteIndex.end(), [&](std::size_t a, std::size_t b) {
+        return instrumentSet[a].maturity < instrumentSet[b].maturity;
+    });
+
+    for (std::size_t i = 0; i < quoteIndex.size(); ++i) {
+        const CurveInstrument& inst = instrumentSet[quoteIndex[i]];
+        if (!(inst.maturity > 0.0)) {
+            throw std::invalid_argument("CurveBootstrapper: maturities must be positive");
+        }
+        if (i > 0 && inst.maturity == times.back()) {
+            throw std::invalid_argument("CurveBootstrapper: two instruments share a maturity");
+        }
+
+        // 2. Par bonds end on a coupon date and share a grid per frequency
+        std::size_t grid = grids.size();
+        if (inst.type == CurveInstrument::Type::ParBond) {
+            if (inst.frequency <= 0) {
+                throw std::invalid_argument("CurveBootstrapper: par bonds need a positive coupon frequency");
+            }
+            double periods = inst.maturity * inst.frequency;
+            if (std::abs(periods - std::round(periods)) > DATE_EPSILON * periods) {
+                throw std::invalid_argument("CurveBootstrapper: par bond maturity must be a whole number of coupon periods");
+            }
+            auto it = std::find_if(grids.begin(), grids.end(),
+                                   [&](const CouponGrid& g) { return g.frequency == inst.frequency; });
+            grid = static_cast<std::size_t>(it - grids.begin());
+            if (it == grids.end()) {
+                grids.push_back({inst.frequency, {0.0}, 0});
+                grids.back().annuity.reserve(datesUpTo(instrumentSet[quoteIndex.back()].maturity, inst.frequency) + 1);
+            }
+        }
+
+        instruments.push_back(inst);
+        gridOf.push_back(grid);
+        times.push_back(inst.maturity);
+    }
+    rates.resize(times.size());
+}
+
+double CurveBootstrapper::solvedDiscountFactor(double t, std::size_t& segment, std::size_t solved) const {
+    if (t <= times[0]) return std::exp(-rates[0] * t); // Flat before the first pillar
+
+    while (segment + 2 < solved && t > times[segment + 1]) ++segment;
+    double w = (t - times[segment]) / (times[segment + 1] - times[segment]);
+    double r = rates[segment] + w * (rates[segment + 1] - rates[segment]);
+    return std::exp(-r * t);
+}
+
+void CurveBootstrapper::extendAnnuity(CouponGrid& grid, std::size_t count, std::size_t solved) {
+    // Only dates already covered by the first `solved` pillars are added,
+    // so entries never change once written
+    while (grid.annuity.size() <= count) {
+        double t = static_cast<double>(grid.annuity.size()) / grid.frequency;
+        grid.annuity.push_back(grid.annuity.back() + solvedDiscountFactor(t, grid.segment, solved));
+    }
+}
+
+double CurveBootstrapper::solveParBond(std::size_t pillar, double coupon) {
+    CouponGrid& grid = grids[gridOf[pillar]];
+    const double dt = 1.0 / grid.frequency;
+    const double maturity = times[pillar];
+    const std::size_t last = datesUpTo(maturity, grid.frequency);
+
+    // 1. Dates up to the previous pillar: fixed, from the running sum
+    std::size_t known = 0;
+    double left = 0.0;
+    double leftRate = 0.0;
+    if (pillar > 0) {
+        left = times[pillar - 1];
+        leftRate = rates[pillar - 1];
+        known = datesUpTo(left, grid.frequency);
+        extendAnnuity(grid, known, pillar);
+    }
+    const double fixedAnnuity = grid.annuity[known];
+
+    // 2. Newton on the new pillar rate x. Dates in the segment have rate
+    //    leftRate + w * (x - leftRate), or x itself on the first pillar
+    double x = pillar > 0 ? leftRate : coupon;
+    for (int step = 0; step < MAX_NEWTON_STEPS; ++step) {
+        double annuity = fixedAnnuity;
+        double dAnnuity = 0.0;
+        double df = 0.0, dDf = 0.0; // Final date, where the principal is paid
+        for (std::size_t k = known + 1; k <= last; ++k) {
+            double t = k * dt;
+            double w = pillar > 0 ? (t - left) / (maturity - left) : 1.0;
+            double r = pillar > 0 ? leftRate + w * (x - leftRate) : x;
+            df = std::exp(-r * t);
+            dDf = -w * t * df;
+            annuity += df;
+            dAnnuity += dDf;
+        }
+
+        double g = coupon * dt * annuity + df - 1.0;
+        double dg = coupon * dt * dAnnuity + dDf;
+        if (!(dg < 0.0) || !std::isfinite(g)) {
+            throw std::runtime_error("CurveBootstrapper: par bond quote has no solution");
+        }
+        double next = x - g / dg;
+        if (std::abs(next - x) <= RATE_TOLERANCE * (1.0 + std::abs(x))) return next;
+        x = next;
+    }
+    return x;
+}
+
+void CurveBootstrapper::bootstrap(const std::vector<double>& quotes, YieldCurve& curve) {
+    if (quotes.size() != instruments.size()) {
+        throw std::invalid_argument("CurveBootstrapper: expected one quote per instrument");
+    }
+
+    // 1. Running sums restart; their buffers are kept
+    for (CouponGrid& grid : grids) {
+        grid.annuity.resize(1);
+        grid.segment = 0;
+    }
+
+    // 2. Pillars in maturity order
+    for (std::size_t k = 0; k < instruments.size(); ++k) {
+        double q = quotes[quoteIndex[k]];
+        double df = 0.0;
+        switch (instruments[k].type) {
+        case CurveInstrument::Type::Deposit:
+            df = 1.0 / (1.0 + q * times[k]);
+            break;
+        case CurveInstrument::Type::ZeroCoupon:
+            df = q / 100.0;
+            break;
+        case CurveInstrument::Type::ParBond:
+            rates[k] = solveParBond(k, q);
+            continue;
+        }
+        if (!(df > 0.0) || !std::isfinite(df)) {
+            throw std::runtime_error("CurveBootstrapper: quote implies a non-positive discount factor");
+        }
+        rates[k] = -std::log(df) / times[k];
+    }
+
+    // 3. Publish: same pillars keep the curve's grid
+    if (curve.getPillarTimes() == times) {
+        curve.setRates(rates);
+    } else {
+        curve = YieldCurve();
+        for (std::size_t k = 0; k < times.size(); ++k) curve.addRate(times[k], rates[k]);
+    }
+}
+
+YieldCurve CurveBootstrapper::bootstrap(const std::vector<double>& quotes) {
+    YieldCurve curve;
+    bootstrap(quotes, curve);
+    return curve;
+}
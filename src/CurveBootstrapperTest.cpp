@@ -0,0 +1,73 @@
+// Bootstrap round trips: every instrument reprices to its quote on the
+// fitted curve, and a rebuild on new quotes keeps the pillar grid
+#include "CurveBootstrapper.hpp"
+#include "Instruments.hpp"
+#include "TestSupport.hpp"
+#include <stdexcept>
+#include <vector>
+
+namespace {
+    constexpr double TOLERANCE = 1e-13; // Relative to the quote's price
+
+    void checkRoundTrip(const std::vector<CurveInstrument>& set, const std::vector<double>& quotes,
+                        const YieldCurve& curve) {
+        for (std::size_t i = 0; i < set.size(); ++i) {
+            const CurveInstrument& inst = set[i];
+            double model = 0.0, market = 0.0;
+            switch (inst.type) {
+            case CurveInstrument::Type::Deposit:
+                model = curve.getDiscountFactor(inst.maturity);
+                market = 1.0 / (1.0 + quotes[i] * inst.maturity);
+                break;
+            case CurveInstrument::Type::ZeroCoupon:
+                model = ZeroCouponBond("ZERO", 100.0, inst.maturity).calculatePrice(curve);
+                market = quotes[i];
+                break;
+            case CurveInstrument::Type::ParBond:
+                model = VanillaBond("PAR", 100.0, inst.maturity, quotes[i], inst.frequency).calculatePrice(curve);
+                market = 100.0;
+                break;
+            }
+            expectRelative("instrument " + std::to_string(i) + " reprices", model, market, TOLERANCE);
+        }
+    }
+}
+
+int main() {
+    // 1. Mixed set, given out of maturity order, with annual, semi-annual and
+    //    quarterly par bonds
+    std::vector<CurveInstrument> set = {
+        CurveInstrument::parBond(10.0, 2), CurveInstrument::deposit(0.25), CurveInstrument::deposit(0.5),
+        CurveInstrument::zeroCoupon(1.0), CurveInstrument::parBond(2.0, 2), CurveInstrument::parBond(3.0, 2),
+        CurveInstrument::parBond(5.0, 2), CurveInstrument::parBond(7.0, 1), CurveInstrument::parBond(30.0, 2),
+        CurveInstrument::parBond(20.0, 2), CurveInstrument::parBond(15.0, 4)};
+    std::vector<double> quotes = {0.045, 0.030, 0.031, 96.9, 0.034, 0.036, 0.039, 0.041, 0.050, 0.048, 0.047};
+
+    CurveBootstrapper bootstrapper(set);
+    YieldCurve curve = bootstrapper.bootstrap(quotes);
+    checkRoundTrip(set, quotes, curve);
+
+    // 2. New quotes on the same curve: rates replaced, grid kept
+    const std::vector<double>* grid = &curve.getPillarTimes();
+    std::uint64_t version = curve.getVersion();
+    quotes[3] = 97.0;
+    quotes[0] = 0.046;
+    bootstrapper.bootstrap(quotes, curve);
+    checkRoundTrip(set, quotes, curve);
+    expectTrue("rebuild keeps the pillar grid", &curve.getPillarTimes() == grid);
+    expectTrue("rebuild moves the version", curve.getVersion() != version);
+
+    // 3. Bad input is rejected
+    try {
+        CurveBootstrapper broken({CurveInstrument::parBond(2.3, 2)});
+        fail("par bond off the coupon grid accepted");
+    } catch (const std::invalid_argument&) {
+    }
+    try {
+        bootstrapper.bootstrap(std::vector<double>(set.size() - 1, 0.03));
+        fail("quote count mismatch accepted");
+    } catch (const std::invalid_argument&) {
+    }
+
+    return testResult("Bootstrapped curve reprices every instrument");
+}
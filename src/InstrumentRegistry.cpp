@@ -0,0 +1,19 @@
+#include "InstrumentRegistry.hpp"
+#include <stdexcept>
+
+InstrumentId InstrumentRegistry::add(Instrument instrument) {
+    if (bonds.size() >= INVALID_INSTRUMENT) {
+        throw std::length_error("InstrumentRegistry: instrument id space exhausted");
+    }
+
+    // A full chunk is left in place; the next one is reserved up front
+    if (chunks.empty() || chunks.back().size() == CHUNK_SIZE) {
+        chunks.emplace_back();
+        chunks.back().reserve(CHUNK_SIZE);
+    }
+    chunks.back().push_back(std::move(instrument));
+
+    auto id = static_cast<InstrumentId>(bonds.size());
+    bonds.push_back(&asBond(chunks.back().back()));
+    return id;
+}
@@ -1,40 +1,50 @@
 #include "Instruments.hpp"
+#include <cstddef>
+#include <stdexcept>
 #include <vector>
 
+namespace {
+    // Number of coupon dates generated by `for (t = dt; t <= maturity + 0.001; t += dt)`
+    std::size_t couponCount(double maturity, double dt)
+    {
+        std::size_t count = 0;
+        for (double t = dt; t <= maturity + 0.001; t += dt) ++count;
+        return count;
+    }
+}
+
 
 // Vanilla Bond
 // =========================================================
 
 VanillaBond::VanillaBond(std::string id, double n, double m, double c, int f)
-    : Bond(id, n, m), couponRate(c), frequency(f) {}
-
-std::vector<CashFlow> VanillaBond::getCashFlows(const YieldCurve & /*curve*/) const
+    : Bond(std::move(id), n, m), couponRate(c), frequency(f)
 {
-    // Note: The curve argument is unused here because coupons are fixed,
-    // but the interface requires it.
-
-    std::vector<CashFlow> flows;
     double dt = 1.0 / frequency; // e.g., 0.5 for semi-annual
     double couponAmount = notional * couponRate * dt;
 
+    std::size_t count = couponCount(maturity, dt);
+    cfTimes.reserve(count > 0 ? count : 1);
+    cfFixed.reserve(count > 0 ? count : 1);
+
     // Generate periodic coupon payments
     for (double t = dt; t <= maturity + 0.001; t += dt)
     {
-        flows.push_back({couponAmount, t});
+        cfTimes.push_back(t);
+        cfFixed.push_back(couponAmount);
     }
 
     // Add the Principal repayment (Notional) at the end
-    if (!flows.empty())
+    if (!cfTimes.empty())
     {
-        flows.back().amount += notional;
+        cfFixed.back() += notional;
     }
     else
     {
         // Edge case: if maturity is very short
-        flows.push_back({notional + couponAmount, maturity});
+        cfTimes.push_back(maturity);
+        cfFixed.push_back(notional + couponAmount);
     }
-
-    return flows;
 }
 
 std::string VanillaBond::getDescription() const
@@ -46,12 +56,11 @@ std::string VanillaBond::getDescription() const
 // Zero Coupon Bond
 // =========================================================
 
-ZeroCouponBond::ZeroCouponBond(std::string id, double n, double m) : Bond(id, n, m) {}
-
-std::vector<CashFlow> ZeroCouponBond::getCashFlows(const YieldCurve & /*curve*/) const
+ZeroCouponBond::ZeroCouponBond(std::string id, double n, double m) : Bond(std::move(id), n, m)
 {
     // Only one cash flow: Notional at Maturity
-    return {{notional, maturity}};
+    cfTimes.push_back(maturity);
+    cfFixed.push_back(notional);
 }
 
 std::string ZeroCouponBond::getDescription() const
@@ -64,35 +73,45 @@ std::string ZeroCouponBond::getDescription() const
 // =========================================================
 
 FloatingRateNote::FloatingRateNote(std::string id, double n, double m, double s, int f)
-    : Bond(id, n, m), spread(s), frequency(f) {}
-
-std::vector<CashFlow> FloatingRateNote::getCashFlows(const YieldCurve &curve) const
+    : Bond(std::move(id), n, m), spread(s), frequency(f)
 {
-    std::vector<CashFlow> flows;
     double dt = 1.0 / frequency;
 
+    std::size_t count = couponCount(maturity, dt);
+    cfTimes.reserve(count);
+    cfFixed.reserve(count);
+    cfAccrual.reserve(count);
+
     for (double t = dt; t <= maturity + 0.001; t += dt)
     {
-        // 1. Estimate the Forward Rate for this period
+        // Coupon = notional * (forwardRate + spread) * dt. The spread part is
+        // fixed; the rate part is projected at pricing time
         // (Simplification: using the spot rate at time t from the curve)
-        double forwardRate = curve.getRate(t);
-
-        // 2. Calculate the variable coupon
-        double couponAmount = notional * (forwardRate + spread) * dt;
-
-        flows.push_back({couponAmount, t});
+        cfTimes.push_back(t);
+        cfFixed.push_back(notional * spread * dt);
+        cfAccrual.push_back(notional * dt);
     }
 
     // Add Principal repayment
-    if (!flows.empty())
+    if (!cfTimes.empty())
     {
-        flows.back().amount += notional;
+        cfFixed.back() += notional;
     }
-
-    return flows;
 }
 
 std::string FloatingRateNote::getDescription() const
 {
     return "Floating Rate Note";
 }
+
+
+// Instrument
+// =========================================================
+
+Instrument toInstrument(const Bond& bond)
+{
+    if (auto vanilla = dynamic_cast<const VanillaBond*>(&bond)) return *vanilla;
+    if (auto zero = dynamic_cast<const ZeroCouponBond*>(&bond)) return *zero;
+    if (auto frn = dynamic_cast<const FloatingRateNote*>(&bond)) return *frn;
+    throw std::invalid_argument("toInstrument: unsupported bond type for " + bond.getTicker());
+}
@@ -0,0 +1,50 @@
+#include "Interpolation.hpp"
+
+namespace {
+    double delta(const double* times, const double* rates, std::size_t i) {
+        return (rates[i + 1] - rates[i]) / (times[i + 1] - times[i]);
+    }
+
+    // Fritsch-Butland tangent at pillar i: one-sided at the ends, zero at a
+    // local extremum, otherwise a weighted harmonic mean of the two slopes
+    double tangent(const double* times, const double* rates, std::size_t pillarCount, std::size_t i) {
+        if (i == 0) return delta(times, rates, 0);
+        if (i + 1 == pillarCount) return delta(times, rates, i - 1);
+
+        double d0 = delta(times, rates, i - 1);
+        double d1 = delta(times, rates, i);
+        if (d0 * d1 <= 0.0) return 0.0;
+
+        double h0 = times[i] - times[i - 1];
+        double h1 = times[i + 1] - times[i];
+        return 3.0 * (h0 + h1) / ((2.0 * h1 + h0) / d0 + (h1 + 2.0 * h0) / d1);
+    }
+}
+
+void LinearOnRate::build(const double* times, const double* rates, std::size_t,
+                         std::size_t first, std::size_t last, Segment* segments) {
+    for (std::size_t i = first; i < last; ++i) {
+        segments[i].slope = delta(times, rates, i);
+    }
+}
+
+void LogLinearOnDiscount::build(const double* times, const double* rates, std::size_t,
+                                std::size_t first, std::size_t last, Segment* segments) {
+    for (std::size_t i = first; i < last; ++i) {
+        segments[i].scale = delta(times, rates, i) * times[i + 1];
+    }
+}
+
+void MonotoneCubicOnRate::build(const double* times, const double* rates, std::size_t pillarCount,
+                                std::size_t first, std::size_t last, Segment* segments) {
+    for (std::size_t i = first; i < last; ++i) {
+        double h = times[i + 1] - times[i];
+        double d = delta(times, rates, i);
+        double m0 = tangent(times, rates, pillarCount, i);
+        double m1 = tangent(times, rates, pillarCount, i + 1);
+
+        segments[i].b = m0;
+        segments[i].c = (3.0 * d - 2.0 * m0 - m1) / h;
+        segments[i].d = (m0 + m1 - 2.0 * d) / (h * h);
+    }
+}
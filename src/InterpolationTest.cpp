@@ -0,0 +1,140 @@
+// Shape of each interpolation policy: pillars reproduced exactly, flat
+// forwards between pillars for log-linear, and no overshoot for the
+// monotone cubic on monotone input
+#include "TestSupport.hpp"
+#include <vector>
+
+namespace {
+    constexpr std::size_t STEPS = 200;    // Sample points per segment
+    constexpr double TOLERANCE = 1e-12;
+
+    // Flat at the short end, a sharp step, then flat again: the shape on
+    // which an unconstrained cubic rings above and below the data
+    constexpr std::size_t STEP_PILLAR_COUNT = 5;
+    constexpr double STEP_TIMES[STEP_PILLAR_COUNT] = {1.0, 2.0, 3.0, 10.0, 30.0};
+    constexpr double STEP_RATES[STEP_PILLAR_COUNT] = {0.020, 0.020, 0.050, 0.050, 0.051};
+
+    template <class Curve>
+    Curve makeStepCurve() {
+        Curve curve;
+        for (std::size_t k = 0; k < STEP_PILLAR_COUNT; ++k) {
+            curve.addRate(STEP_TIMES[k], STEP_RATES[k]);
+        }
+        return curve;
+    }
+
+    // Every pillar rate comes back exactly, single and batch
+    template <class Curve>
+    void checkPillars(const std::string& name, const Curve& curve, const double* times,
+                      const double* rates, std::size_t count) {
+        std::vector<double> batch(count);
+        curve.getRates(times, batch.data(), count);
+        for (std::size_t k = 0; k < count; ++k) {
+            std::string pillar = name + " pillar " + std::to_string(k);
+            expectTrue(pillar + " rate", curve.getRate(times[k]) == rates[k]);
+            expectTrue(pillar + " batch rate", batch[k] == rates[k]);
+        }
+    }
+
+    // Rates on a grid of STEPS points across segment i, both ends included
+    template <class Curve>
+    std::vector<double> sampleSegment(const Curve& curve, const double* times, std::size_t i,
+                                      std::vector<double>& t) {
+        t.resize(STEPS + 1);
+        for (std::size_t j = 0; j <= STEPS; ++j) {
+            t[j] = times[i] + (times[i + 1] - times[i]) * static_cast<double>(j) / STEPS;
+        }
+        std::vector<double> rates(t.size());
+        curve.getRates(t.data(), rates.data(), t.size());
+        return rates;
+    }
+
+    // -d ln DF / dt between consecutive samples equals the segment's
+    // pillar-to-pillar forward everywhere inside it
+    void checkFlatForwards(const std::string& name, const LogLinearYieldCurve& curve,
+                           const double* times, const double* rates, std::size_t count) {
+        std::vector<double> t;
+        for (std::size_t i = 0; i + 1 < count; ++i) {
+            double forward = (rates[i + 1] * times[i + 1] - rates[i] * times[i]) / (times[i + 1] - times[i]);
+            std::vector<double> r = sampleSegment(curve, times, i, t);
+            for (std::size_t j = 0; j < STEPS; ++j) {
+                double local = (r[j + 1] * t[j + 1] - r[j] * t[j]) / (t[j + 1] - t[j]);
+                expectNear(name + " forward in segment " + std::to_string(i), local, forward, 1e-9);
+            }
+        }
+    }
+
+    // On non-decreasing pillars the rate never decreases and stays inside
+    // [rates[i], rates[i + 1]] on each segment
+    void checkMonotone(const std::string& name, const MonotoneCubicYieldCurve& curve,
+                       const double* times, const double* rates, std::size_t count) {
+        std::vector<double> t;
+        for (std::size_t i = 0; i + 1 < count; ++i) {
+            std::string segment = name + " segment " + std::to_string(i);
+            std::vector<double> r = sampleSegment(curve, times, i, t);
+            for (std::size_t j = 0; j <= STEPS; ++j) {
+                expectTrue(segment + " within pillars",
+                           r[j] >= rates[i] - TOLERANCE && r[j] <= rates[i + 1] + TOLERANCE);
+                if (j > 0) expectTrue(segment + " non-decreasing", r[j] >= r[j - 1] - TOLERANCE);
+            }
+        }
+    }
+
+    // The linear key-rate weights rebuild the interpolated rate
+    void checkLinearWeights(const YieldCurve& curve, const double* times, const double* rates,
+                            std::size_t count) {
+        std::vector<double> t;
+        for (std::size_t i = 0; i + 1 < count; ++i) {
+            std::vector<double> r = sampleSegment(curve, times, i, t);
+            std::vector<std::size_t> left(t.size());
+            std::vector<double> w(t.size());
+            curve.getPillarWeights(t.data(), left.data(), w.data(), t.size());
+            for (std::size_t j = 0; j < t.size(); ++j) {
+                double rebuilt = (1.0 - w[j]) * rates[left[j]] + (w[j] != 0.0 ? w[j] * rates[left[j] + 1] : 0.0);
+                expectNear("linear weights, segment " + std::to_string(i), rebuilt, r[j], TOLERANCE);
+            }
+        }
+    }
+}
+
+int main() {
+    const double* times = TEST_PILLAR_TIMES;
+    const double* rates = TEST_PILLAR_RATES;
+
+    // 1. Every policy goes through its pillars
+    checkPillars("linear", makeTestCurve<YieldCurve>(), times, rates, TEST_PILLAR_COUNT);
+    checkPillars("log-linear", makeTestCurve<LogLinearYieldCurve>(), times, rates, TEST_PILLAR_COUNT);
+    checkPillars("monotone cubic", makeTestCurve<MonotoneCubicYieldCurve>(), times, rates, TEST_PILLAR_COUNT);
+    checkPillars("step monotone cubic", makeStepCurve<MonotoneCubicYieldCurve>(),
+                 STEP_TIMES, STEP_RATES, STEP_PILLAR_COUNT);
+
+    // 2. Log-linear discounting means flat forwards between pillars
+    checkFlatForwards("log-linear", makeTestCurve<LogLinearYieldCurve>(), times, rates, TEST_PILLAR_COUNT);
+    checkFlatForwards("step log-linear", makeStepCurve<LogLinearYieldCurve>(),
+                      STEP_TIMES, STEP_RATES, STEP_PILLAR_COUNT);
+
+    // 3. The monotone cubic neither overshoots nor turns back, including
+    //    across the step and on the flat pieces either side of it
+    checkMonotone("monotone cubic", makeTestCurve<MonotoneCubicYieldCurve>(), times, rates, TEST_PILLAR_COUNT);
+    checkMonotone("step monotone cubic", makeStepCurve<MonotoneCubicYieldCurve>(),
+                  STEP_TIMES, STEP_RATES, STEP_PILLAR_COUNT);
+
+    // 4. Moving one pillar rebuilds only the segments it reaches, with the
+    //    same coefficients as a curve built from scratch
+    MonotoneCubicYieldCurve bumped = makeTestCurve<MonotoneCubicYieldCurve>();
+    bumped.bumpPillar(1, 25.0);
+    MonotoneCubicYieldCurve rebuilt = makeTestCurve<MonotoneCubicYieldCurve>(1, 25.0);
+    std::vector<double> t;
+    for (std::size_t i = 0; i + 1 < TEST_PILLAR_COUNT; ++i) {
+        std::vector<double> a = sampleSegment(bumped, times, i, t);
+        std::vector<double> b = sampleSegment(rebuilt, times, i, t);
+        for (std::size_t j = 0; j < a.size(); ++j) {
+            expectNear("bumped monotone cubic, segment " + std::to_string(i), a[j], b[j], TOLERANCE);
+        }
+    }
+
+    // 5. Linear key-rate weights are exact for the linear curve
+    checkLinearWeights(makeTestCurve<YieldCurve>(), times, rates, TEST_PILLAR_COUNT);
+
+    return testResult("Interpolation policies reproduce pillars and keep their shape");
+}
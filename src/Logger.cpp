@@ -0,0 +1,228 @@
+#include "Logger.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+
+namespace {
+    // Longest the log thread sleeps without being woken; bounds how long an
+    // exited thread's ring is kept
+    constexpr auto IDLE_TIMEOUT = std::chrono::milliseconds(100);
+
+    // Set once this thread's rings have been released
+    thread_local bool threadExiting = false;
+
+    std::uint64_t nextLoggerId() {
+        static std::atomic<std::uint64_t> counter{0};
+        return ++counter;
+    }
+
+    // Shortest readable form, like an ostream's default formatting
+    void appendNumber(std::string& buffer, double x) {
+        char text[32];
+        int n = std::snprintf(text, sizeof(text), "%g", x);
+        buffer.append(text, static_cast<std::size_t>(n));
+    }
+}
+
+struct Logger::ThreadRings {
+    std::vector<std::pair<std::uint64_t, std::shared_ptr<Ring>>> owned; // Logger id, ring
+
+    ~ThreadRings() {
+        threadExiting = true;
+        cachedId = 0;
+        for (auto& entry : owned) entry.second->retired.store(true, std::memory_order_release);
+    }
+};
+
+thread_local std::uint64_t Logger::cachedId = 0;
+thread_local Logger::Ring* Logger::cachedRing = nullptr;
+
+Logger::Ring::Ring(std::size_t capacity) {
+    std::size_t size = 2;
+    while (size < capacity) size *= 2;
+    records.reset(new LogRecord[size]);
+    mask = size - 1;
+}
+
+Logger::Logger(std::size_t ringCapacity)
+    : ringCapacity(ringCapacity), id(nextLoggerId()), out(&std::cout), err(&std::cerr) {
+    drainer = std::thread(&Logger::drainLoop, this);
+}
+
+Logger::~Logger() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    drainer.join();
+    flush();
+
+    // Threads still holding rings drop them on their next miss or at exit
+    std::lock_guard<std::mutex> lock(drainMutex);
+    for (const auto& ring : rings) ring->orphaned.store(true, std::memory_order_relaxed);
+}
+
+Logger& Logger::instance() {
+    static Logger logger;
+    return logger;
+}
+
+void Logger::setSinks(std::ostream& outStream, std::ostream& errStream) {
+    std::lock_guard<std::mutex> lock(drainMutex);
+    drainLocked(); // Pending records go to the old sinks
+    out = &outStream;
+    err = &errStream;
+}
+
+Logger::Ring* Logger::localRing() {
+    if (threadExiting) return nullptr;
+    thread_local ThreadRings local;
+
+    // 1. A ring this thread already has for this logger; rings of destroyed
+    //    loggers are released on the way
+    auto& owned = local.owned;
+    owned.erase(std::remove_if(owned.begin(), owned.end(),
+                               [](const auto& entry) { return entry.second->orphaned.load(std::memory_order_relaxed); }),
+                owned.end());
+    auto it = std::find_if(owned.begin(), owned.end(), [&](const auto& entry) { return entry.first == id; });
+
+    // 2. First record from this thread: a new ring, shared with the drainer
+    if (it == owned.end()) {
+        auto ring = std::make_shared<Ring>(ringCapacity);
+        {
+            std::lock_guard<std::mutex> lock(drainMutex);
+            rings.push_back(ring);
+        }
+        owned.emplace_back(id, std::move(ring));
+        it = owned.end() - 1;
+    }
+
+    cachedId = id;
+    cachedRing = it->second.get();
+    return cachedRing;
+}
+
+void Logger::push(const LogRecord& record) {
+    Ring* ring = cachedId == id ? cachedRing : localRing();
+    if (ring == nullptr) return;
+
+    std::uint64_t head = ring->head.load(std::memory_order_relaxed);
+    if (head - ring->tail.load(std::memory_order_acquire) > ring->mask) {
+        ring->dropped.fetch_add(1, std::memory_order_relaxed); // Full: never block the caller
+        return;
+    }
+    ring->records[head & ring->mask] = record;
+
+    // seq_cst pairs with drainLoop: either the drainer sees this record
+    // before sleeping, or this thread sees it going to sleep and wakes it
+    ring->head.store(head + 1, std::memory_order_seq_cst);
+    if (drainerIdle.load(std::memory_order_seq_cst) && drainerIdle.exchange(false)) {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        wake.notify_one();
+    }
+}
+
+void Logger::format(const LogRecord& r, std::string& buffer) const {
+    const double* v = r.values;
+    switch (r.event) {
+    case LogEvent::Message:
+        buffer += r.text;
+        break;
+    case LogEvent::InstrumentRegistered:
+        buffer += "Registered Instrument: ";
+        buffer += r.text;
+        break;
+    case LogEvent::TradeBooked:
+        buffer += v[0] > 0 ? "[TRADE] BUY " : "[TRADE] SELL ";
+        appendNumber(buffer, std::abs(v[0]));
+        buffer += " of ";
+        buffer += r.text;
+        buffer += " @ ";
+        appendNumber(buffer, v[1]);
+        buffer += " (Mid: ";
+        appendNumber(buffer, v[2]);
+        buffer += ") | Edge Captured: ";
+        appendNumber(buffer, v[3]);
+        break;
+    case LogEvent::UnknownInstrument:
+        buffer += "Error: Bond not found (id ";
+        appendNumber(buffer, v[0]);
+        buffer += ").";
+        break;
+    }
+    buffer += '\n';
+}
+
+bool Logger::hasPending() {
+    std::lock_guard<std::mutex> lock(drainMutex);
+    for (const auto& ring : rings) {
+        if (ring->head.load(std::memory_order_seq_cst) != ring->tail.load(std::memory_order_relaxed)) return true;
+    }
+    return false;
+}
+
+void Logger::drainLocked() {
+    for (auto it = rings.begin(); it != rings.end();) {
+        const auto& ring = *it;
+        // Read before draining: a retired ring gets no records after this
+        bool retired = ring->retired.load(std::memory_order_acquire);
+        std::uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+        std::uint64_t head = ring->head.load(std::memory_order_acquire);
+        for (; tail != head; ++tail) {
+            const LogRecord& record = ring->records[tail & ring->mask];
+            format(record, record.level >= LogLevel::Warn ? errBuffer : outBuffer);
+        }
+        ring->tail.store(tail, std::memory_order_release);
+
+        std::uint64_t dropped = ring->dropped.exchange(0, std::memory_order_relaxed);
+        if (dropped > 0) {
+            errBuffer += "[LOG] ";
+            appendNumber(errBuffer, static_cast<double>(dropped));
+            errBuffer += " records dropped (ring full)\n";
+        }
+
+        // Owner thread gone and nothing left to read: free the ring
+        if (retired) it = rings.erase(it);
+        else ++it;
+    }
+
+    // One write and one flush per pass
+    if (!outBuffer.empty()) {
+        out->write(outBuffer.data(), static_cast<std::streamsize>(outBuffer.size()));
+        out->flush();
+        outBuffer.clear();
+    }
+    if (!errBuffer.empty()) {
+        err->write(errBuffer.data(), static_cast<std::streamsize>(errBuffer.size()));
+        err->flush();
+        errBuffer.clear();
+    }
+}
+
+void Logger::flush() {
+    std::lock_guard<std::mutex> lock(drainMutex);
+    drainLocked();
+}
+
+std::size_t Logger::getRingCount() const {
+    std::lock_guard<std::mutex> lock(drainMutex);
+    return rings.size();
+}
+
+void Logger::drainLoop() {
+    std::unique_lock<std::mutex> wakeLock(wakeMutex);
+    while (!stopping) {
+        wakeLock.unlock();
+        flush();
+        wakeLock.lock();
+
+        // Announce the sleep, then look once more: a record pushed after
+        // the flush is either seen here or its producer sees the flag
+        drainerIdle.store(true, std::memory_order_seq_cst);
+        if (!stopping && !hasPending()) wake.wait_for(wakeLock, IDLE_TIMEOUT);
+        drainerIdle.store(false, std::memory_order_relaxed);
+    }
+}
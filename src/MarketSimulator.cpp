@@ -0,0 +1,130 @@
+#include "MarketSimulator.hpp"
+#include "Philox.hpp"
+#include "TradingBook.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // Paths per pool task; each task reuses one curve and inventory buffer
+    constexpr std::size_t PATHS_PER_TASK = 64;
+}
+
+DistributionSummary DistributionSummary::of(std::vector<double> samples)
+{
+    DistributionSummary d;
+    if (samples.empty()) return d;
+
+    std::sort(samples.begin(), samples.end());
+    auto quantile = [&](double q) {
+        return samples[static_cast<std::size_t>(q * static_cast<double>(samples.size() - 1) + 0.5)];
+    };
+
+    double sum = 0.0;
+    for (double x : samples) sum += x;
+    d.mean = sum / static_cast<double>(samples.size());
+
+    double sq = 0.0;
+    for (double x : samples) sq += (x - d.mean) * (x - d.mean);
+    d.stdev = samples.size() > 1 ? std::sqrt(sq / static_cast<double>(samples.size() - 1)) : 0.0;
+
+    d.min = samples.front();
+    d.p01 = quantile(0.01);
+    d.p05 = quantile(0.05);
+    d.p50 = quantile(0.50);
+    d.p95 = quantile(0.95);
+    d.p99 = quantile(0.99);
+    d.max = samples.back();
+    return d;
+}
+
+MarketSimulator::MarketSimulator(std::vector<std::shared_ptr<Bond>> universe, const YieldCurve& curve,
+                                 ThreadPool& pool)
+    : universe(std::move(universe)), baseCurve(curve), pool(pool) {}
+
+PathResult MarketSimulator::runPath(const SimulationConfig& config, std::uint64_t pathId,
+                                    YieldCurve& curve, std::vector<double>& inventory) const
+{
+    PhiloxStream rng(config.seed, pathId);
+
+    // Reset the path state (assignment reuses the buffers' capacity)
+    curve = baseCurve;
+    std::fill(inventory.begin(), inventory.end(), 0.0);
+
+    PathResult result{0.0, 0.0, 0.0, 0.0, 0};
+    double cash = 0.0;
+
+    for (std::size_t step = 0; step < config.steps; ++step)
+    {
+        // 1. Market move
+        curve.parallelShift(rng.normal() * config.curveVolBps);
+        if (config.twistVolBps != 0.0) curve.twist(config.twistPivot, rng.normal() * config.twistVolBps);
+
+        // 2. Client picks a bond; we quote around the exact mid
+        //    (uncached evaluation: other paths price the same bond concurrently)
+        std::size_t idx = static_cast<std::size_t>(rng.uniform() * static_cast<double>(universe.size()));
+        Sensitivities sens = universe[idx]->computeSensitivities(curve);
+        Quote quote = TradingBook::computeQuote(sens.price, sens.pv01, inventory[idx],
+                                                config.baseSpread, config.riskAversion);
+
+        // 3. Client order and fill decision
+        bool clientBuys = rng.uniform() < 0.5;
+        double tradeSize = std::abs(config.tradeSizeMean + config.tradeSizeStdev * rng.normal());
+        double executePrice = clientBuys ? quote.ask : quote.bid;
+        double quantityForUs = clientBuys ? -tradeSize : tradeSize;
+
+        double probOfTrade = std::exp(-std::abs(executePrice - sens.price));
+        if (rng.uniform() < probOfTrade)
+        {
+            inventory[idx] += quantityForUs;
+            cash -= quantityForUs * executePrice;
+            result.spreadPnL += (sens.price - executePrice) * quantityForUs;
+            ++result.fills;
+        }
+    }
+
+    // 4. Mark the final inventory on the final curve
+    double markValue = 0.0;
+    for (std::size_t i = 0; i < universe.size(); ++i)
+    {
+        if (inventory[i] == 0.0) continue;
+        Sensitivities sens = universe[i]->computeSensitivities(curve);
+        markValue += inventory[i] * sens.price;
+        result.netPV01 += inventory[i] * sens.pv01;
+        result.grossInventory += std::abs(inventory[i]);
+    }
+    result.totalPnL = cash + markValue;
+    return result;
+}
+
+SimulationResult MarketSimulator::run(const SimulationConfig& config) const
+{
+    SimulationResult result;
+    result.paths.resize(config.paths);
+    if (universe.empty()) return result;
+
+    std::size_t tasks = (config.paths + PATHS_PER_TASK - 1) / PATHS_PER_TASK;
+    pool.parallelFor(tasks, [&](std::size_t task) {
+        YieldCurve curve = baseCurve;
+        std::vector<double> inventory(universe.size(), 0.0);
+
+        std::size_t begin = task * PATHS_PER_TASK;
+        std::size_t end = std::min(begin + PATHS_PER_TASK, config.paths);
+        for (std::size_t p = begin; p < end; ++p)
+        {
+            result.paths[p] = runPath(config, p, curve, inventory);
+        }
+    });
+
+    // Distributions, computed serially in path order
+    std::vector<double> samples(config.paths);
+    auto summarise = [&](double PathResult::*field) {
+        for (std::size_t p = 0; p < config.paths; ++p) samples[p] = result.paths[p].*field;
+        return DistributionSummary::of(samples);
+    };
+    result.totalPnL = summarise(&PathResult::totalPnL);
+    result.spreadPnL = summarise(&PathResult::spreadPnL);
+    result.grossInventory = summarise(&PathResult::grossInventory);
+    result.netPV01 = summarise(&PathResult::netPV01);
+    return result;
+}
@@ -1,47 +1,208 @@
-#include "Instruments.hpp"
-#include <random>
-#include <memory>
-#include <vector>
+#include "PortfolioGenerator.hpp"
+#include "Philox.hpp"
+#include <algorithm>
+#include <charconv>
+#include <iterator>
+#include <stdexcept>
 #include <string>
 
-class PortfolioGenerator {
-private:
-    std::mt19937 rng; // Mersenne Twister Random Engine
-
-public:
-    PortfolioGenerator() : rng(std::random_device{}()) {}
-
-    std::shared_ptr<Bond> generateRandomBond(int id) {
-        // Randomly decide bond characteristics
-        std::uniform_int_distribution<int> typeDist(0, 2); // 0=Vanilla, 1=FRN, 2=Zero
-        std::uniform_int_distribution<int> matDist(2, 30); // 2 to 30 years
-        std::uniform_real_distribution<double> cpnDist(0.01, 0.06); // 1% to 6% coupon
-
-        int maturity = matDist(rng);
-        double coupon = cpnDist(rng);
-        std::string ticker = "BOND_" + std::to_string(id) + "_" + std::to_string(maturity) + "Y";
-
-        int type = typeDist(rng);
-        
-        if (type == 0) { // Vanilla
-             // Govt bonds often pay Semi-Annual (freq=2)
-            return std::make_shared<VanillaBond>(ticker, 100.0, (double)maturity, coupon, 2);
-        } 
-        else if (type == 1) { // FRN
-            // FRNs usually have a spread over SOFR/Euribor (e.g., 0.5% to 2.5%)
-            double spread = cpnDist(rng) * 0.5; 
-            return std::make_shared<FloatingRateNote>(ticker + "_FRN", 100.0, (double)maturity, spread, 4); // Quarterly
-        } 
-        else { // Zero Coupon
-            return std::make_shared<ZeroCouponBond>(ticker + "_ZERO", 100.0, (double)maturity);
+namespace {
+    // Bonds whose terms are drawn per pool task
+    constexpr std::size_t SPECS_PER_TASK = 16384;
+
+    constexpr double NOTIONAL = 100.0;
+    constexpr int VANILLA_FREQUENCY = 2; // Govt bonds often pay semi-annually
+    constexpr int FRN_FREQUENCY = 4;     // Quarterly
+
+    // BOND_<id>_<m>Y, with _FRN / _ZERO for the other types, written in place
+    std::string makeTicker(std::size_t id, int maturity, BondSpec::Type type) {
+        char buffer[48];
+        char* end = buffer + 32; // Number room; the rest is for '_', 'Y' and the suffix
+        char* p = buffer;
+        auto append = [&p](const char* text) {
+            while (*text) *p++ = *text++;
+        };
+
+        append("BOND_");
+        p = std::to_chars(p, end, id).ptr;
+        *p++ = '_';
+        p = std::to_chars(p, end, maturity).ptr;
+        *p++ = 'Y';
+        if (type == BondSpec::Type::Floating) append("_FRN");
+        else if (type == BondSpec::Type::ZeroCoupon) append("_ZERO");
+        return std::string(buffer, p);
+    }
+
+    template <class T>
+    void moveAppend(std::vector<T>& store, std::vector<T>& block) {
+        store.insert(store.end(), std::make_move_iterator(block.begin()), std::make_move_iterator(block.end()));
+    }
+
+    Instrument buildInstrument(std::size_t index, const BondSpec& spec) {
+        std::string ticker = makeTicker(index + 1, spec.maturity, spec.type); // IDs start at 1
+        double maturity = static_cast<double>(spec.maturity);
+
+        switch (spec.type) {
+        case BondSpec::Type::Vanilla:
+            return VanillaBond(std::move(ticker), NOTIONAL, maturity, spec.couponRate, VANILLA_FREQUENCY);
+        case BondSpec::Type::Floating:
+            return FloatingRateNote(std::move(ticker), NOTIONAL, maturity, spec.couponRate, FRN_FREQUENCY);
+        default:
+            return ZeroCouponBond(std::move(ticker), NOTIONAL, maturity);
         }
     }
+}
+
+std::vector<std::shared_ptr<Bond>> InstrumentUniverse::share(const std::shared_ptr<InstrumentUniverse>& universe) {
+    std::vector<std::shared_ptr<Bond>> handles;
+    handles.reserve(universe->bonds.size());
+    for (Bond* bond : universe->bonds) {
+        handles.emplace_back(universe, bond); // Aliasing: owns the universe, points at the bond
+    }
+    return handles;
+}
+
+PortfolioGenerator::PortfolioGenerator(std::uint64_t seed, const PortfolioMix& mix) : seed(seed) {
+    double total = mix.vanilla + mix.floating + mix.zeroCoupon;
+    if (mix.vanilla < 0.0 || mix.floating < 0.0 || mix.zeroCoupon < 0.0 || !(total > 0.0)) {
+        throw std::invalid_argument("PortfolioGenerator: mix weights must be non-negative with a positive total");
+    }
+    vanillaCutoff = mix.vanilla / total;
+    floatingCutoff = (mix.vanilla + mix.floating) / total;
+}
+
+BondSpec PortfolioGenerator::describeBond(std::size_t index) const {
+    PhiloxStream rng(seed, index);
+    BondSpec spec;
+
+    double typeDraw = rng.uniform();
+    if (typeDraw < vanillaCutoff) spec.type = BondSpec::Type::Vanilla;
+    else if (typeDraw < floatingCutoff) spec.type = BondSpec::Type::Floating;
+    else spec.type = BondSpec::Type::ZeroCoupon;
+
+    spec.maturity = 2 + static_cast<int>(rng.uniform() * 29.0); // 2 to 30 years
+    double coupon = 0.01 + 0.05 * rng.uniform();                // 1% to 6%
 
-    std::vector<std::shared_ptr<Bond>> generatePortfolio(int count) {
-        std::vector<std::shared_ptr<Bond>> port;
-        for (int i = 0; i < count; ++i) {
-            port.push_back(generateRandomBond(i + 1)); // IDs start at 1
+    // FRNs usually pay a spread over SOFR/Euribor (0.5% to 3%)
+    spec.couponRate = spec.type == BondSpec::Type::Floating ? coupon * 0.5 : coupon;
+    return spec;
+}
+
+std::shared_ptr<Bond> PortfolioGenerator::generateBond(std::size_t index) const {
+    return std::visit([](auto&& bond) -> std::shared_ptr<Bond> {
+        using Type = std::decay_t<decltype(bond)>;
+        return std::make_shared<Type>(std::move(bond));
+    }, buildInstrument(index, describeBond(index)));
+}
+
+InstrumentUniverse PortfolioGenerator::generateUniverse(std::size_t count, ThreadPool& pool) const {
+    InstrumentUniverse universe;
+
+    // 1. Each task draws and builds a contiguous index range into its own
+    //    per-type blocks, in generation order (bonds have their own streams)
+    struct Chunk {
+        std::vector<VanillaBond> vanillaBonds;
+        std::vector<FloatingRateNote> floatingNotes;
+        std::vector<ZeroCouponBond> zeroCouponBonds;
+    };
+    std::size_t tasks = (count + SPECS_PER_TASK - 1) / SPECS_PER_TASK;
+    std::vector<Chunk> chunks(tasks);
+    std::vector<BondSpec::Type> types(count);
+    pool.parallelFor(tasks, [&](std::size_t task) {
+        Chunk& chunk = chunks[task];
+        std::size_t begin = task * SPECS_PER_TASK;
+        std::size_t end = std::min(begin + SPECS_PER_TASK, count);
+        for (std::size_t i = begin; i < end; ++i) {
+            BondSpec spec = describeBond(i);
+            types[i] = spec.type;
+
+            std::string ticker = makeTicker(i + 1, spec.maturity, spec.type);
+            double maturity = static_cast<double>(spec.maturity);
+
+            switch (spec.type) {
+            case BondSpec::Type::Vanilla:
+                chunk.vanillaBonds.emplace_back(std::move(ticker), NOTIONAL, maturity, spec.couponRate,
+                                                VANILLA_FREQUENCY);
+                break;
+            case BondSpec::Type::Floating:
+                chunk.floatingNotes.emplace_back(std::move(ticker), NOTIONAL, maturity, spec.couponRate,
+                                                 FRN_FREQUENCY);
+                break;
+            case BondSpec::Type::ZeroCoupon:
+                chunk.zeroCouponBonds.emplace_back(std::move(ticker), NOTIONAL, maturity);
+                break;
+            }
+        }
+    });
+
+    // 2. Prefix counts give each chunk its offset in every store. The stores
+    //    are reserved exactly and never reallocate; moving a bond only moves
+    //    its schedule buffers.
+    std::vector<std::size_t> offsets(tasks * 3);
+    std::size_t totals[3] = {0, 0, 0};
+    for (std::size_t task = 0; task < tasks; ++task) {
+        const Chunk& chunk = chunks[task];
+        const std::size_t sizes[3] = {chunk.vanillaBonds.size(), chunk.floatingNotes.size(),
+                                      chunk.zeroCouponBonds.size()};
+        for (std::size_t type = 0; type < 3; ++type) {
+            offsets[task * 3 + type] = totals[type];
+            totals[type] += sizes[type];
         }
-        return port;
     }
-};
\ No newline at end of file
+    universe.vanillaBonds.reserve(totals[0]);
+    universe.floatingNotes.reserve(totals[1]);
+    universe.zeroCouponBonds.reserve(totals[2]);
+    for (Chunk& chunk : chunks) {
+        moveAppend(universe.vanillaBonds, chunk.vanillaBonds);
+        moveAppend(universe.floatingNotes, chunk.floatingNotes);
+        moveAppend(universe.zeroCouponBonds, chunk.zeroCouponBonds);
+    }
+
+    // 3. Generation-order handles, over the same index ranges
+    universe.bonds.resize(count);
+    pool.parallelFor(tasks, [&](std::size_t task) {
+        std::size_t next[3] = {offsets[task * 3], offsets[task * 3 + 1], offsets[task * 3 + 2]};
+        std::size_t begin = task * SPECS_PER_TASK;
+        std::size_t end = std::min(begin + SPECS_PER_TASK, count);
+        for (std::size_t i = begin; i < end; ++i) {
+            switch (types[i]) {
+            case BondSpec::Type::Vanilla:
+                universe.bonds[i] = &universe.vanillaBonds[next[0]++];
+                break;
+            case BondSpec::Type::Floating:
+                universe.bonds[i] = &universe.floatingNotes[next[1]++];
+                break;
+            case BondSpec::Type::ZeroCoupon:
+                universe.bonds[i] = &universe.zeroCouponBonds[next[2]++];
+                break;
+            }
+        }
+    });
+    return universe;
+}
+
+std::vector<Instrument> PortfolioGenerator::generateInstruments(std::size_t count, ThreadPool& pool) const {
+    // 1. Each task draws and builds a contiguous block (bonds have their own streams)
+    std::size_t tasks = (count + SPECS_PER_TASK - 1) / SPECS_PER_TASK;
+    std::vector<std::vector<Instrument>> blocks(tasks);
+    pool.parallelFor(tasks, [&](std::size_t task) {
+        std::size_t begin = task * SPECS_PER_TASK;
+        std::size_t end = std::min(begin + SPECS_PER_TASK, count);
+        blocks[task].reserve(end - begin);
+        for (std::size_t i = begin; i < end; ++i) blocks[task].push_back(buildInstrument(i, describeBond(i)));
+    });
+
+    // 2. Concatenate in generation order; moving a bond only moves its schedule buffers
+    std::vector<Instrument> instruments;
+    instruments.reserve(count);
+    for (auto& block : blocks) {
+        instruments.insert(instruments.end(), std::make_move_iterator(block.begin()),
+                           std::make_move_iterator(block.end()));
+    }
+    return instruments;
+}
+
+std::vector<std::shared_ptr<Bond>> PortfolioGenerator::generatePortfolio(std::size_t count) const {
+    auto universe = std::make_shared<InstrumentUniverse>(generateUniverse(count));
+    return InstrumentUniverse::share(universe);
+}
@@ -0,0 +1,229 @@
+#include "PortfolioPricer.hpp"
+#include "TradingBook.hpp"
+#include "RiskEngine.hpp"
+#include "VectorMath.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+    // Flows are discounted in stack blocks through the batch curve API
+    constexpr std::size_t BLOCK = 256;
+}
+
+PortfolioPricer::PortfolioPricer(const TradingBook& book) {
+    for (const Position& pos : book.getPositions()) {
+        if (pos.quantity == 0) continue; // Skip flat positions
+        addLine(*pos.instrument, pos.quantity, pos.averageCost);
+    }
+}
+
+PortfolioPricer::PortfolioPricer(const std::vector<std::shared_ptr<Bond>>& bonds) : owned(bonds) {
+    for (const auto& bond : bonds) {
+        addLine(*bond, 1.0, 0.0);
+    }
+}
+
+void PortfolioPricer::addLine(const Bond& bond, double quantity, double averageCost) {
+    auto line = static_cast<std::uint32_t>(instruments.size());
+    const auto& times = bond.getCashFlowTimes();
+    const auto& fixed = bond.getFixedAmounts();
+
+    FlowGroup& group = bond.hasFloatingCoupons() ? floatingFlows : fixedFlows;
+    group.times.insert(group.times.end(), times.begin(), times.end());
+    group.fixed.insert(group.fixed.end(), fixed.begin(), fixed.end());
+    group.line.insert(group.line.end(), times.size(), line);
+    if (bond.hasFloatingCoupons()) {
+        const auto& accrual = bond.getFloatingAccruals();
+        group.accrual.insert(group.accrual.end(), accrual.begin(), accrual.end());
+    }
+
+    instruments.push_back(&bond);
+    quantities.push_back(quantity);
+    averageCosts.push_back(averageCost);
+}
+
+void PortfolioPricer::sweepFixed(const FlowGroup& group, const YieldCurve& curve,
+                                 std::size_t begin, std::size_t end,
+                                 double* prices, double* pv01s) {
+    double dfs[BLOCK];
+
+    // amount * DF, and dP/dy = -t * amount * DF as in Bond::calculateSensitivities
+    for (std::size_t start = begin; start < end; start += BLOCK) {
+        std::size_t n = std::min(BLOCK, end - start);
+        curve.getDiscountFactors(group.times.data() + start, dfs, n);
+        for (std::size_t i = 0; i < n; ++i) {
+            std::size_t k = start + i;
+            double pv = group.fixed[k] * dfs[i];
+            prices[group.line[k]] += pv;
+            if (pv01s) pv01s[group.line[k]] -= group.times[k] * pv;
+        }
+    }
+}
+
+void PortfolioPricer::sweepFloating(const FlowGroup& group, const YieldCurve& curve,
+                                    std::size_t begin, std::size_t end,
+                                    double* prices, double* pv01s) {
+    double rates[BLOCK];
+    double dfs[BLOCK];
+
+    // (fixed + accrual * rate) * DF; the projection adds accrual * DF to dP/dy
+    for (std::size_t start = begin; start < end; start += BLOCK) {
+        std::size_t n = std::min(BLOCK, end - start);
+        curve.getRatesAndDiscountFactors(group.times.data() + start, rates, dfs, n);
+        for (std::size_t i = 0; i < n; ++i) {
+            std::size_t k = start + i;
+            double pv = (group.fixed[k] + group.accrual[k] * rates[i]) * dfs[i];
+            prices[group.line[k]] += pv;
+            if (pv01s) pv01s[group.line[k]] += group.accrual[k] * dfs[i] - group.times[k] * pv;
+        }
+    }
+}
+
+void PortfolioPricer::priceLines(const YieldCurve& curve, std::size_t lineBegin,
+                                 std::size_t lineEnd, double* prices, double* pv01s) const {
+    std::fill(prices + lineBegin, prices + lineEnd, 0.0);
+    if (pv01s) std::fill(pv01s + lineBegin, pv01s + lineEnd, 0.0);
+
+    // Flows are stored in line order, so a line range is a flow range per group
+    auto flowRange = [&](const FlowGroup& g) {
+        auto first = std::lower_bound(g.line.begin(), g.line.end(), lineBegin);
+        auto last = std::lower_bound(first, g.line.end(), lineEnd);
+        return std::make_pair(static_cast<std::size_t>(first - g.line.begin()),
+                              static_cast<std::size_t>(last - g.line.begin()));
+    };
+
+    auto [fixedBegin, fixedEnd] = flowRange(fixedFlows);
+    sweepFixed(fixedFlows, curve, fixedBegin, fixedEnd, prices, pv01s);
+
+    auto [floatBegin, floatEnd] = flowRange(floatingFlows);
+    sweepFloating(floatingFlows, curve, floatBegin, floatEnd, prices, pv01s);
+
+    if (pv01s) {
+        for (std::size_t i = lineBegin; i < lineEnd; ++i) pv01s[i] *= 1e-4;
+    }
+}
+
+void PortfolioPricer::priceLines(const YieldCurve& curve, std::vector<double>& prices) const {
+    prices.resize(instruments.size());
+    priceLines(curve, 0, instruments.size(), prices.data(), nullptr);
+}
+
+void PortfolioPricer::priceLines(const YieldCurve& curve, std::vector<double>& prices,
+                                 std::vector<double>& pv01s) const {
+    prices.resize(instruments.size());
+    pv01s.resize(instruments.size());
+    priceLines(curve, 0, instruments.size(), prices.data(), pv01s.data());
+}
+
+void PortfolioPricer::keyRatePV01(const YieldCurve& curve, std::vector<double>& lineKeyRates) const {
+    const std::size_t pillars = curve.getPillarCount();
+    lineKeyRates.assign(instruments.size() * pillars, 0.0);
+
+    // Each line's flows are contiguous within its group
+    for (const FlowGroup* g : {&fixedFlows, &floatingFlows}) {
+        for (std::size_t begin = 0; begin < g->times.size();) {
+            std::uint32_t line = g->line[begin];
+            std::size_t end = begin;
+            while (end < g->times.size() && g->line[end] == line) ++end;
+
+            RiskEngine::accumulateKeyRatePV01(curve, g->times.data() + begin, g->fixed.data() + begin,
+                                              g->accrual.empty() ? nullptr : g->accrual.data() + begin,
+                                              end - begin, 1.0, lineKeyRates.data() + line * pillars);
+            begin = end;
+        }
+    }
+}
+
+std::vector<double> PortfolioPricer::bookKeyRatePV01(const YieldCurve& curve) const {
+    std::vector<double> book(curve.getPillarCount(), 0.0);
+
+    // Quantity-weighted straight into the book buckets, no per-line rows
+    for (const FlowGroup* g : {&fixedFlows, &floatingFlows}) {
+        for (std::size_t begin = 0; begin < g->times.size();) {
+            std::uint32_t line = g->line[begin];
+            std::size_t end = begin;
+            while (end < g->times.size() && g->line[end] == line) ++end;
+
+            RiskEngine::accumulateKeyRatePV01(curve, g->times.data() + begin, g->fixed.data() + begin,
+                                              g->accrual.empty() ? nullptr : g->accrual.data() + begin,
+                                              end - begin, quantities[line], book.data());
+            begin = end;
+        }
+    }
+    return book;
+}
+
+void PortfolioPricer::scenarioPnL(const YieldCurve& curve, const std::vector<CurveScenario>& scenarios,
+                                  std::vector<double>& linePnL) const {
+    const std::size_t scenarioCount = scenarios.size();
+    const std::size_t pillars = curve.getPillarCount();
+    linePnL.assign(instruments.size() * scenarioCount, 0.0);
+    if (pillars == 0) return;
+
+    // Shocks as rate changes, padded with a zero column so the right-hand
+    // pillar of a flat-extrapolated flow (weight 0) needs no branch
+    std::vector<double> shocks(scenarioCount * (pillars + 1), 0.0);
+    for (std::size_t s = 0; s < scenarioCount; ++s) {
+        if (scenarios[s].size() != pillars) {
+            throw std::invalid_argument("PortfolioPricer::scenarioPnL: expected one shift per pillar");
+        }
+        for (std::size_t k = 0; k < pillars; ++k) {
+            shocks[s * (pillars + 1) + k] = scenarios[s][k] / 10000.0;
+        }
+    }
+
+    double rates[BLOCK];
+    double dfs[BLOCK];
+    double weights[BLOCK];
+    std::size_t left[BLOCK];
+    double basePv[BLOCK];
+    double shifts[BLOCK];
+    double growth[BLOCK];
+
+    for (const FlowGroup* g : {&fixedFlows, &floatingFlows}) {
+        const bool floating = !g->accrual.empty();
+
+        for (std::size_t start = 0; start < g->times.size(); start += BLOCK) {
+            std::size_t n = std::min(BLOCK, g->times.size() - start);
+            const double* times = g->times.data() + start;
+            const double* fixed = g->fixed.data() + start;
+            const double* accrual = floating ? g->accrual.data() + start : nullptr;
+            const std::uint32_t* line = g->line.data() + start;
+
+            // 1. Base curve, once per flow
+            curve.getRatesAndDiscountFactors(times, rates, dfs, n);
+            curve.getPillarWeights(times, left, weights, n);
+            for (std::size_t i = 0; i < n; ++i) {
+                double amount = fixed[i] + (floating ? accrual[i] * rates[i] : 0.0);
+                basePv[i] = amount * dfs[i];
+            }
+
+            // 2. Scenario-major: each scenario sweeps the block
+            for (std::size_t s = 0; s < scenarioCount; ++s) {
+                const double* shock = shocks.data() + s * (pillars + 1);
+                for (std::size_t i = 0; i < n; ++i) {
+                    shifts[i] = (1.0 - weights[i]) * shock[left[i]] + weights[i] * shock[left[i] + 1];
+                    growth[i] = -shifts[i] * times[i];
+                }
+                expInPlace(growth, n); // DF(shocked) / DF(base)
+                for (std::size_t i = 0; i < n; ++i) {
+                    double amount = fixed[i] + (floating ? accrual[i] * (rates[i] + shifts[i]) : 0.0);
+                    double pv = amount * dfs[i] * growth[i];
+                    linePnL[line[i] * scenarioCount + s] += quantities[line[i]] * (pv - basePv[i]);
+                }
+            }
+        }
+    }
+}
+
+double PortfolioPricer::marketValue(const YieldCurve& curve) const {
+    std::vector<double> prices;
+    priceLines(curve, prices);
+
+    double total = 0.0;
+    for (std::size_t i = 0; i < prices.size(); ++i) {
+        total += quantities[i] * prices[i];
+    }
+    return total;
+}
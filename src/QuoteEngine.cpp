@@ -0,0 +1,44 @@
+#include "QuoteEngine.hpp"
+#include <algorithm>
+
+namespace {
+    // Instruments repriced per pool task on a curve change
+    constexpr std::size_t REFRESH_CHUNK = 256;
+}
+
+QuoteEngine::QuoteEngine(const TradingBook& book, double baseSpread, ThreadPool& pool)
+    : book(book), pool(pool), baseSpread(baseSpread) {}
+
+void QuoteEngine::refresh(const YieldCurve& curve) {
+    const std::vector<Position>& positions = book.getPositions();
+    const std::size_t known = states.size();
+    states.resize(positions.size());
+
+    // 1. Mids and PV01s: all of them on a new curve, otherwise only new instruments
+    std::size_t first = curve.getVersion() == quotedVersion ? known : 0;
+    std::size_t count = positions.size() - first;
+    std::size_t chunks = (count + REFRESH_CHUNK - 1) / REFRESH_CHUNK;
+    pool.parallelFor(chunks, [&](std::size_t chunk) {
+        std::size_t begin = first + chunk * REFRESH_CHUNK;
+        std::size_t end = std::min(begin + REFRESH_CHUNK, positions.size());
+        for (std::size_t id = begin; id < end; ++id) {
+            Sensitivities sens = positions[id].instrument->calculateSensitivities(curve);
+            states[id].mid = sens.price;
+            states[id].unitPV01 = sens.pv01;
+        }
+    });
+    quotedVersion = curve.getVersion();
+
+    // 2. Inventory straight from the book (includes every fill so far)
+    for (std::size_t id = 0; id < positions.size(); ++id) {
+        states[id].inventory = positions[id].quantity;
+    }
+}
+
+void QuoteEngine::quoteAll(Quote* out) const {
+    const double riskAversion = book.getRiskAversion();
+    for (std::size_t id = 0; id < states.size(); ++id) {
+        const QuoteState& s = states[id];
+        out[id] = TradingBook::computeQuote(s.mid, s.unitPV01, s.inventory, baseSpread, riskAversion);
+    }
+}
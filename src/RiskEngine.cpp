@@ -1,29 +1,110 @@
 #include "RiskEngine.hpp"
-#include <iostream>
+#include "ThreadPool.hpp"
+#include "PortfolioPricer.hpp"
+#include "Logger.hpp"
+#include <algorithm>
 #include <iomanip>
+#include <iostream>
+#include <sstream>
 
 double RiskEngine::calculatePV01(const Bond& bond, const YieldCurve& baseCurve) {
-    // 1. Calculate price with the base curve
-    double priceBase = bond.calculatePrice(baseCurve);
+    // dP/dy is closed-form for exp(-r t) discounting, so no bump-and-reprice
+    return bond.calculateSensitivities(baseCurve).pv01;
+}
+
+Sensitivities RiskEngine::calculateSensitivities(const Bond& bond, const YieldCurve& baseCurve) {
+    return bond.calculateSensitivities(baseCurve);
+}
+
+void RiskEngine::calculateSensitivities(const std::vector<Instrument>& instruments,
+                                        const YieldCurve& baseCurve, std::vector<Sensitivities>& out,
+                                        ThreadPool& pool) {
+    constexpr std::size_t CHUNK = 1024; // Instruments per pool task
+    out.resize(instruments.size());
+    std::size_t tasks = (instruments.size() + CHUNK - 1) / CHUNK;
+    pool.parallelFor(tasks, [&](std::size_t task) {
+        std::size_t end = std::min(instruments.size(), (task + 1) * CHUNK);
+        for (std::size_t i = task * CHUNK; i < end; ++i) {
+            out[i] = computeSensitivities(instruments[i], baseCurve);
+        }
+    });
+}
+
+std::vector<double> RiskEngine::calculateKeyRatePV01(const Bond& bond, const YieldCurve& baseCurve) {
+    std::vector<double> keyRates(baseCurve.getPillarCount(), 0.0);
+    const auto& accrual = bond.getFloatingAccruals();
+    accumulateKeyRatePV01(baseCurve, bond.getCashFlowTimes().data(), bond.getFixedAmounts().data(),
+                          accrual.empty() ? nullptr : accrual.data(),
+                          bond.getCashFlowTimes().size(), 1.0, keyRates.data());
+    return keyRates;
+}
 
-    // 2. Create a copy of the curve and apply a +1 bp shift (0.01%)
-    YieldCurve shockedCurve = baseCurve;
-    shockedCurve.parallelShift(1.0); 
+void RiskEngine::accumulateKeyRatePV01(const YieldCurve& curve, const double* times,
+                                       const double* fixed, const double* accrual,
+                                       std::size_t n, double scale, double* out) {
+    if (curve.getPillarCount() == 0) return;
 
-    // 3. Calculate price with the shocked curve
-    double priceShock = bond.calculatePrice(shockedCurve);
+    constexpr std::size_t BLOCK = 64;
+    double rates[BLOCK];
+    double dfs[BLOCK];
+    double weights[BLOCK];
+    std::size_t left[BLOCK];
 
-    // 4. Return the difference
-    return priceShock - priceBase;
+    // A bump h on pillar k moves rate(t) by h * weight_k(t), so
+    // dP/dr_k = sum weight_k * (A - t * amount) * DF, the parallel dP/dy split by weight
+    for (std::size_t start = 0; start < n; start += BLOCK) {
+        std::size_t m = std::min(BLOCK, n - start);
+        curve.getRatesAndDiscountFactors(times + start, rates, dfs, m);
+        curve.getPillarWeights(times + start, left, weights, m);
+
+        for (std::size_t i = 0; i < m; ++i) {
+            std::size_t k = start + i;
+            double amount = fixed[k];
+            double dAmount = 0.0;
+            if (accrual) {
+                amount += accrual[k] * rates[i];
+                dAmount = accrual[k];
+            }
+            double dPdr = (dAmount - times[k] * amount) * dfs[i] * 1e-4 * scale;
+
+            out[left[i]] += (1.0 - weights[i]) * dPdr;
+            if (weights[i] != 0.0) out[left[i] + 1] += weights[i] * dPdr;
+        }
+    }
+}
+
+StressGridResult RiskEngine::runStressGrid(const PortfolioPricer& portfolio,
+                                           const YieldCurve& baseCurve,
+                                           const std::vector<StressScenario>& scenarios) {
+    StressGridResult result;
+    std::vector<CurveScenario> shifts;
+    shifts.reserve(scenarios.size());
+    for (const auto& scenario : scenarios) {
+        result.scenarioNames.push_back(scenario.name);
+        shifts.push_back(scenario.pillarShiftsBps);
+    }
+
+    portfolio.scenarioPnL(baseCurve, shifts, result.linePnL);
+
+    // Book totals, summed in line order
+    result.scenarioPnL.assign(scenarios.size(), 0.0);
+    for (std::size_t line = 0; line < portfolio.lineCount(); ++line) {
+        for (std::size_t s = 0; s < scenarios.size(); ++s) {
+            result.scenarioPnL[s] += result.at(line, s);
+        }
+    }
+    return result;
 }
 
 void RiskEngine::runStressTest(const std::vector<std::unique_ptr<Bond>>& portfolio, 
                                const YieldCurve& baseCurve, 
                                double shiftBps) {
-    
-    std::cout << " STRESS TEST REPORT (Shift: " << shiftBps << " bps)" << std::endl;
-    std::cout << "==============================================" << std::endl;
-    
+    // The report is output, not diagnostics: it is built in one buffer and
+    // written directly, so none of it can be dropped by the logger
+    std::ostringstream report;
+    report << " STRESS TEST REPORT (Shift: " << shiftBps << " bps)\n";
+    report << "==============================================\n";
+
     // Create the stressed market environment
     YieldCurve stressedCurve = baseCurve;
     stressedCurve.parallelShift(shiftBps);
@@ -32,30 +113,79 @@ void RiskEngine::runStressTest(const std::vector<std::unique_ptr<Bond>>& portfol
     double totalStressedVal = 0.0;
 
     // Formatting for clean table output
-    std::cout << std::left << std::setw(20) << "Instrument" 
-              << std::right << std::setw(12) << "Base Price" 
-              << std::setw(12) << "New Price" 
-              << std::setw(12) << "P&L" << std::endl;
-    std::cout << std::string(56, '-') << std::endl;
-
-    for (const auto& bond : portfolio) {
-        double pBase = bond->calculatePrice(baseCurve);
-        double pStress = bond->calculatePrice(stressedCurve);
+    report << std::left << std::setw(20) << "Instrument"
+           << std::right << std::setw(12) << "Base Price"
+           << std::setw(12) << "New Price"
+           << std::setw(12) << "P&L" << "\n";
+    report << std::string(56, '-') << "\n";
+
+    // Price every bond under both curves in parallel, then report and sum
+    // serially so the totals do not depend on the thread count
+    std::vector<double> basePrices(portfolio.size());
+    std::vector<double> stressedPrices(portfolio.size());
+    constexpr std::size_t CHUNK = 1024; // Bonds per pool task
+    std::size_t tasks = (portfolio.size() + CHUNK - 1) / CHUNK;
+    ThreadPool::instance().parallelFor(tasks, [&](std::size_t task) {
+        std::size_t end = std::min(portfolio.size(), (task + 1) * CHUNK);
+        for (std::size_t i = task * CHUNK; i < end; ++i) {
+            basePrices[i] = portfolio[i]->calculatePrice(baseCurve);
+            stressedPrices[i] = portfolio[i]->calculatePrice(stressedCurve);
+        }
+    });
+
+    for (std::size_t i = 0; i < portfolio.size(); ++i) {
+        double pBase = basePrices[i];
+        double pStress = stressedPrices[i];
         double diff = pStress - pBase;
         
         totalBaseVal += pBase;
         totalStressedVal += pStress;
 
-        std::cout << std::left << std::setw(20) << bond->getDescription() 
-                  << std::right << std::fixed << std::setprecision(2) 
-                  << std::setw(12) << pBase 
-                  << std::setw(12) << pStress 
-                  << std::setw(12) << diff << std::endl;
+        report << std::left << std::setw(20) << portfolio[i]->getDescription()
+               << std::right << std::fixed << std::setprecision(2)
+               << std::setw(12) << pBase
+               << std::setw(12) << pStress
+               << std::setw(12) << diff << "\n";
     }
 
-    std::cout << std::string(56, '-') << std::endl;
+    report << std::string(56, '-') << "\n";
     double totalPnL = totalStressedVal - totalBaseVal;
-    
-    std::cout << "TOTAL PORTFOLIO P&L IMPACT: " << totalPnL << std::endl;
-    std::cout << "==============================================\n" << std::endl;
+
+    report << "TOTAL PORTFOLIO P&L IMPACT: " << totalPnL << "\n";
+    report << "==============================================\n\n";
+
+    // One write and one flush, after the records logged before the report
+    Logger::instance().flush();
+    std::cout << report.str() << std::flush;
+}
+
+// Stress Scenarios
+// =========================================================
+
+namespace {
+    // Shortest round-trip text for scenario names ("25", "-12.5")
+    std::string formatNumber(double x) {
+        std::ostringstream os;
+        os << x;
+        return os.str();
+    }
+}
+
+StressScenario StressScenario::parallel(const YieldCurve& curve, double bps) {
+    return {"Parallel " + formatNumber(bps) + "bp", CurveScenario(curve.getPillarCount(), bps)};
+}
+
+StressScenario StressScenario::twist(const YieldCurve& curve, double pivot, double bps) {
+    return {"Twist " + formatNumber(bps) + "bp @" + formatNumber(pivot) + "Y", curve.twistShifts(pivot, bps)};
+}
+
+StressScenario StressScenario::butterfly(const YieldCurve& curve, double belly, double bps) {
+    return {"Butterfly " + formatNumber(bps) + "bp @" + formatNumber(belly) + "Y",
+            curve.butterflyShifts(belly, bps)};
+}
+
+StressScenario StressScenario::pillarBump(const YieldCurve& curve, std::size_t index, double bps) {
+    CurveScenario shifts(curve.getPillarCount(), 0.0);
+    shifts.at(index) = bps;
+    return {"Pillar " + formatNumber(curve.getPillarTimes()[index]) + "Y " + formatNumber(bps) + "bp", shifts};
 }
@@ -0,0 +1,50 @@
+// Key-rate PV01 against central differences of pillar-bumped prices, and
+// the buckets summing to the parallel PV01
+#include "Instruments.hpp"
+#include "RiskEngine.hpp"
+#include "TestSupport.hpp"
+#include <memory>
+#include <vector>
+
+namespace {
+    constexpr double BUMP_BPS = 1.0;
+    constexpr double TOLERANCE = 1e-9; // Per 100 notional
+}
+
+int main() {
+    YieldCurve curve = makeTestCurve();
+
+    std::vector<std::unique_ptr<Bond>> bonds;
+    bonds.push_back(std::make_unique<VanillaBond>("VANILLA_30Y", 100.0, 30.0, 0.05, 2));
+    bonds.push_back(std::make_unique<VanillaBond>("VANILLA_7Y", 100.0, 7.0, 0.04, 1));
+    bonds.push_back(std::make_unique<ZeroCouponBond>("ZERO_10Y", 100.0, 10.0));
+    bonds.push_back(std::make_unique<FloatingRateNote>("FRN_20Y", 100.0, 20.0, 0.004, 4));
+
+    for (const auto& bond : bonds) {
+        const std::string& name = bond->getTicker();
+        std::vector<double> keyRates = RiskEngine::calculateKeyRatePV01(*bond, curve);
+        if (keyRates.size() != TEST_PILLAR_COUNT) {
+            fail(name + ": one bucket per pillar");
+            continue;
+        }
+
+        // 1. Each bucket is the price change for a 1bp bump of its pillar.
+        //    Five-point stencil: the O(h^4) truncation error is far below tolerance
+        double sum = 0.0;
+        for (std::size_t k = 0; k < TEST_PILLAR_COUNT; ++k) {
+            double up = bond->calculatePrice(makeTestCurve(k, BUMP_BPS));
+            double down = bond->calculatePrice(makeTestCurve(k, -BUMP_BPS));
+            double up2 = bond->calculatePrice(makeTestCurve(k, 2.0 * BUMP_BPS));
+            double down2 = bond->calculatePrice(makeTestCurve(k, -2.0 * BUMP_BPS));
+            double bumpPV01 = (8.0 * (up - down) - (up2 - down2)) / (12.0 * BUMP_BPS);
+
+            expectNear(name + " key rate PV01, pillar " + std::to_string(k), keyRates[k], bumpPV01, TOLERANCE);
+            sum += keyRates[k];
+        }
+
+        // 2. Buckets add up to the parallel PV01
+        expectNear(name + " bucket sum", sum, RiskEngine::calculatePV01(*bond, curve), TOLERANCE);
+    }
+
+    return testResult("Key-rate PV01 matches pillar bumps");
+}
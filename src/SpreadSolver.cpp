@@ -0,0 +1,195 @@
+#include "SpreadSolver.hpp"
+#include "VectorMath.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+namespace {
+    constexpr std::size_t LANES = SpreadSolver::LANES;
+    constexpr std::size_t BLOCKS_PER_TASK = 64; // LANES bonds per block
+    constexpr double MAX_STEP = 0.5;            // Largest Newton step before a bracket exists
+    constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+
+    // Flows of up to LANES bonds, interleaved: flow k of lane l at [k * LANES + l].
+    // Short lanes are padded with zero weights.
+    struct LaneBlock {
+        std::size_t flowCount = 0;
+        std::vector<double> times;
+        std::vector<double> weights; // Present value of each flow at zero spread
+        std::vector<double> work;
+    };
+
+    // Weights of one bond into its lane: projected amount, discounted on the
+    // curve for a Z-spread and undiscounted for a yield
+    void loadLane(LaneBlock& block, std::size_t lane, const Bond& bond, const YieldCurve& curve,
+                  bool overCurve) {
+        constexpr std::size_t CHUNK = 64;
+        double rates[CHUNK];
+        double dfs[CHUNK];
+
+        const auto& times = bond.getCashFlowTimes();
+        const auto& fixed = bond.getFixedAmounts();
+        const auto& accrual = bond.getFloatingAccruals();
+        for (std::size_t start = 0; start < times.size(); start += CHUNK) {
+            std::size_t n = std::min(CHUNK, times.size() - start);
+            curve.getRatesAndDiscountFactors(times.data() + start, rates, dfs, n);
+            for (std::size_t i = 0; i < n; ++i) {
+                std::size_t k = start + i;
+                double amount = fixed[k];
+                if (!accrual.empty()) amount += accrual[k] * rates[i];
+                block.times[k * LANES + lane] = times[k];
+                block.weights[k * LANES + lane] = overCurve ? amount * dfs[i] : amount;
+            }
+        }
+    }
+
+    void solveBlock(LaneBlock& block, const double* prices, std::size_t lanes, double tolerance,
+                    int maxIterations, SpreadResult* out) {
+        const std::size_t n = block.flowCount * LANES;
+        double s[LANES], lo[LANES], hi[LANES];
+        bool done[LANES];
+
+        // 1. Start from the exact answer for a single flow at the PV-weighted time
+        for (std::size_t l = 0; l < LANES; ++l) {
+            out[l] = SpreadResult{NaN, 0, false};
+            done[l] = true;
+            if (l >= lanes) continue;
+
+            double pv = 0.0, pvTime = 0.0;
+            for (std::size_t k = 0; k < block.flowCount; ++k) {
+                pv += block.weights[k * LANES + l];
+                pvTime += block.weights[k * LANES + l] * block.times[k * LANES + l];
+            }
+            if (!(prices[l] > 0.0) || !(pv > 0.0) || !(pvTime > 0.0)) continue; // No root
+
+            s[l] = std::log(pv / prices[l]) / (pvTime / pv);
+            lo[l] = -std::numeric_limits<double>::infinity();
+            hi[l] = std::numeric_limits<double>::infinity();
+            done[l] = false;
+        }
+
+        for (int iteration = 1; iteration <= maxIterations; ++iteration) {
+            if (std::all_of(done, done + LANES, [](bool d) { return d; })) break;
+
+            // 2. exp(-s * t) for every flow of every lane in one vector pass
+            double* x = block.work.data();
+            for (std::size_t k = 0; k < n; k += LANES) {
+                for (std::size_t l = 0; l < LANES; ++l) x[k + l] = -(done[l] ? 0.0 : s[l]) * block.times[k + l];
+            }
+            expInPlace(x, n);
+
+            // 3. f(s) = sum w * exp(-s t) - price, f'(s) = -sum t * w * exp(-s t)
+            double f[LANES] = {}, df[LANES] = {};
+            for (std::size_t k = 0; k < n; k += LANES) {
+                for (std::size_t l = 0; l < LANES; ++l) {
+                    double pv = block.weights[k + l] * x[k + l];
+                    f[l] += pv;
+                    df[l] -= block.times[k + l] * pv;
+                }
+            }
+
+            // 4. Safeguarded Newton step per lane. f is decreasing in s, so
+            //    the sign of f says which side of the root s is on
+            for (std::size_t l = 0; l < LANES; ++l) {
+                if (done[l]) continue;
+                f[l] -= prices[l];
+                out[l].iterations = iteration;
+                if (std::abs(f[l]) <= tolerance * prices[l]) {
+                    out[l].value = s[l];
+                    out[l].converged = true;
+                    done[l] = true;
+                    continue;
+                }
+                if (f[l] > 0.0) lo[l] = s[l];
+                else hi[l] = s[l];
+
+                double next = s[l] - f[l] / df[l];
+                bool bracketed = std::isfinite(lo[l]) && std::isfinite(hi[l]);
+                if (bracketed && !(next > lo[l] && next < hi[l])) {
+                    next = 0.5 * (lo[l] + hi[l]);
+                } else if (!bracketed) {
+                    next = std::clamp(next, s[l] - MAX_STEP, s[l] + MAX_STEP);
+                }
+                if (next == s[l]) { // No representable progress left
+                    out[l].value = s[l];
+                    done[l] = true;
+                    continue;
+                }
+                s[l] = next;
+                out[l].value = s[l];
+            }
+        }
+    }
+}
+
+SpreadSolver::SpreadSolver(ThreadPool& pool, double tolerance, int maxIterations)
+    : pool(pool), tolerance(tolerance), maxIterations(maxIterations) {}
+
+void SpreadSolver::solve(const std::vector<const Bond*>& bonds, const std::vector<double>& prices,
+                         const YieldCurve& curve, bool overCurve, std::vector<SpreadResult>& out) const {
+    if (bonds.size() != prices.size()) {
+        throw std::invalid_argument("SpreadSolver: need one price per bond");
+    }
+    out.resize(bonds.size());
+
+    // 1. Group bonds of similar length so lanes in a block pad little
+    std::vector<std::size_t> order(bonds.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        return bonds[a]->getCashFlowTimes().size() < bonds[b]->getCashFlowTimes().size();
+    });
+
+    // 2. Blocks of LANES bonds, a run of blocks per pool task
+    std::size_t blocks = (bonds.size() + LANES - 1) / LANES;
+    std::size_t tasks = (blocks + BLOCKS_PER_TASK - 1) / BLOCKS_PER_TASK;
+    pool.parallelFor(tasks, [&](std::size_t task) {
+        LaneBlock block;
+        std::size_t lastBlock = std::min(blocks, (task + 1) * BLOCKS_PER_TASK);
+        for (std::size_t b = task * BLOCKS_PER_TASK; b < lastBlock; ++b) {
+            std::size_t first = b * LANES;
+            std::size_t lanes = std::min(LANES, bonds.size() - first);
+
+            block.flowCount = 0;
+            for (std::size_t l = 0; l < lanes; ++l) {
+                block.flowCount = std::max(block.flowCount, bonds[order[first + l]]->getCashFlowTimes().size());
+            }
+            block.times.assign(block.flowCount * LANES, 0.0);
+            block.weights.assign(block.flowCount * LANES, 0.0);
+            block.work.resize(block.flowCount * LANES);
+
+            double blockPrices[LANES] = {};
+            for (std::size_t l = 0; l < lanes; ++l) {
+                loadLane(block, l, *bonds[order[first + l]], curve, overCurve);
+                blockPrices[l] = prices[order[first + l]];
+            }
+
+            SpreadResult results[LANES];
+            solveBlock(block, blockPrices, lanes, tolerance, maxIterations, results);
+            for (std::size_t l = 0; l < lanes; ++l) out[order[first + l]] = results[l];
+        }
+    });
+}
+
+SpreadResult SpreadSolver::yieldToMaturity(const Bond& bond, double price, const YieldCurve& curve) const {
+    std::vector<SpreadResult> out;
+    solve({&bond}, {price}, curve, false, out);
+    return out[0];
+}
+
+SpreadResult SpreadSolver::zSpread(const Bond& bond, double price, const YieldCurve& curve) const {
+    std::vector<SpreadResult> out;
+    solve({&bond}, {price}, curve, true, out);
+    return out[0];
+}
+
+void SpreadSolver::yieldsToMaturity(const std::vector<const Bond*>& bonds, const std::vector<double>& prices,
+                                    const YieldCurve& curve, std::vector<SpreadResult>& out) const {
+    solve(bonds, prices, curve, false, out);
+}
+
+void SpreadSolver::zSpreads(const std::vector<const Bond*>& bonds, const std::vector<double>& prices,
+                            const YieldCurve& curve, std::vector<SpreadResult>& out) const {
+    solve(bonds, prices, curve, true, out);
+}
@@ -0,0 +1,78 @@
+// Batch yield and Z-spread inversion against a std::exp reference model:
+// prices are generated from known spreads on 100k generated bonds and the
+// solver must recover them
+#include "PortfolioGenerator.hpp"
+#include "SpreadSolver.hpp"
+#include "TestSupport.hpp"
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace {
+    constexpr std::size_t BOND_COUNT = 100000;
+    constexpr double TOLERANCE = 1e-10; // On the recovered yield or spread
+    constexpr double YIELD_OFFSET = 0.03;
+
+    // Price at spread s: over the curve for a Z-spread, flat for a yield.
+    // Floating coupons are projected on the curve, as in the solver
+    double referencePrice(const Bond& bond, const YieldCurve& curve, double s, bool overCurve) {
+        const auto& times = bond.getCashFlowTimes();
+        const auto& fixed = bond.getFixedAmounts();
+        const auto& accrual = bond.getFloatingAccruals();
+        double price = 0.0;
+        for (std::size_t i = 0; i < times.size(); ++i) {
+            double r = curve.getRate(times[i]);
+            double amount = fixed[i] + (accrual.empty() ? 0.0 : accrual[i] * r);
+            price += amount * std::exp(-((overCurve ? r : 0.0) + s) * times[i]);
+        }
+        return price;
+    }
+
+    void check(const char* what, const std::vector<SpreadResult>& results, const std::vector<double>& expected) {
+        double maxError = 0.0;
+        std::size_t unconverged = 0;
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            if (!results[i].converged) ++unconverged;
+            double error = std::abs(results[i].value - expected[i]);
+            maxError = std::max(maxError, std::isnan(error) ? std::numeric_limits<double>::infinity() : error);
+        }
+        expectTrue(std::string(what) + ": every bond converges", unconverged == 0);
+        expectNear(std::string(what) + ": max error", maxError, 0.0, TOLERANCE);
+    }
+}
+
+int main() {
+    YieldCurve curve = makeTestCurve();
+
+    // 1. Known spreads from -2% to 6%, and prices implied by them
+    std::vector<Instrument> instruments = PortfolioGenerator(3).generateInstruments(BOND_COUNT);
+    std::vector<const Bond*> bonds;
+    std::vector<double> spreads, zPrices, yields, yPrices;
+    for (std::size_t i = 0; i < instruments.size(); ++i) {
+        const Bond& bond = asBond(instruments[i]);
+        double s = static_cast<double>((i * 7919) % 1000) / 1000.0 * 0.08 - 0.02;
+        bonds.push_back(&bond);
+        spreads.push_back(s);
+        zPrices.push_back(referencePrice(bond, curve, s, true));
+        yields.push_back(s + YIELD_OFFSET);
+        yPrices.push_back(referencePrice(bond, curve, s + YIELD_OFFSET, false));
+    }
+
+    // 2. Batch inversions recover them
+    SpreadSolver solver;
+    std::vector<SpreadResult> results;
+    solver.zSpreads(bonds, zPrices, curve, results);
+    check("Z-spread", results, spreads);
+    solver.yieldsToMaturity(bonds, yPrices, curve, results);
+    check("yield to maturity", results, yields);
+
+    // 3. Single-bond entry points agree with the batch, and an impossible
+    //    price reports no solution
+    SpreadResult single = solver.zSpread(*bonds[5], zPrices[5], curve);
+    expectTrue("single Z-spread converges", single.converged);
+    expectNear("single Z-spread", single.value, spreads[5], TOLERANCE);
+    SpreadResult negative = solver.zSpread(*bonds[5], -1.0, curve);
+    expectTrue("negative price has no solution", !negative.converged && std::isnan(negative.value));
+
+    return testResult("Spread solver recovers every spread and yield");
+}
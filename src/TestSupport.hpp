@@ -0,0 +1,58 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include "YieldCurve.hpp"
+
+// Shared scaffolding for the ctest checks (src/*Test.cpp). Each check
+// records failures here and main() ends with `return testResult(...)`.
+
+// Reference market: zero rates at 1/5/10/30Y
+constexpr std::size_t TEST_PILLAR_COUNT = 4;
+constexpr double TEST_PILLAR_TIMES[TEST_PILLAR_COUNT] = {1.0, 5.0, 10.0, 30.0};
+constexpr double TEST_PILLAR_RATES[TEST_PILLAR_COUNT] = {0.030, 0.040, 0.050, 0.055};
+
+// The reference curve, optionally with pillar `bumped` moved by bps
+template <class Curve = YieldCurve>
+Curve makeTestCurve(std::size_t bumped = TEST_PILLAR_COUNT, double bps = 0.0) {
+    Curve curve;
+    for (std::size_t k = 0; k < TEST_PILLAR_COUNT; ++k) {
+        curve.addRate(TEST_PILLAR_TIMES[k], TEST_PILLAR_RATES[k] + (k == bumped ? bps * 1e-4 : 0.0));
+    }
+    return curve;
+}
+
+inline int& testFailures() {
+    static int failures = 0;
+    return failures;
+}
+
+inline void fail(const std::string& what) {
+    std::printf("FAIL %s\n", what.c_str());
+    ++testFailures();
+}
+
+inline void expectTrue(const std::string& what, bool condition) {
+    if (!condition) fail(what);
+}
+
+// |actual - expected| <= tolerance (NaN fails)
+inline void expectNear(const std::string& what, double actual, double expected, double tolerance) {
+    if (!(std::abs(actual - expected) <= tolerance)) {
+        std::printf("FAIL %s: got %.17g, expected %.17g\n", what.c_str(), actual, expected);
+        ++testFailures();
+    }
+}
+
+// Tolerance relative to |expected|
+inline void expectRelative(const std::string& what, double actual, double expected, double tolerance) {
+    expectNear(what, actual, expected, tolerance * std::abs(expected));
+}
+
+// Exit code for main: 0 and a one-line summary if every check passed
+inline int testResult(const char* summary) {
+    if (testFailures() > 0) return 1;
+    std::printf("%s\n", summary);
+    return 0;
+}
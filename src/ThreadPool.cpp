@@ -0,0 +1,100 @@
+#include "ThreadPool.hpp"
+
+namespace {
+    thread_local bool insidePoolTask = false;
+}
+
+ThreadPool::ThreadPool(std::size_t threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::thread::hardware_concurrency();
+        if (threadCount == 0) threadCount = 1;
+    }
+    workers.reserve(threadCount - 1);
+    for (std::size_t i = 1; i < threadCount; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeWorkers.notify_all();
+    for (auto& t : workers) t.join();
+}
+
+ThreadPool& ThreadPool::instance() {
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::runTasks() {
+    insidePoolTask = true;
+    for (std::size_t i = nextTask.fetch_add(1); i < taskCount; i = nextTask.fetch_add(1)) {
+        try {
+            (*task)(i);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!firstError) firstError = std::current_exception();
+            nextTask.store(taskCount); // Abandon the remaining tasks
+        }
+    }
+    insidePoolTask = false;
+}
+
+void ThreadPool::workerLoop() {
+    std::size_t seenGeneration = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeWorkers.wait(lock, [&] { return stopping || generation != seenGeneration; });
+            if (stopping) return;
+            seenGeneration = generation;
+        }
+
+        runTasks();
+
+        // Every worker checks in for every job, so the next job cannot start
+        // while one is still reading this one's state
+        bool last;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            last = (++workersDone == workers.size());
+        }
+        if (last) jobDone.notify_one();
+    }
+}
+
+void ThreadPool::parallelFor(std::size_t count, const std::function<void(std::size_t)>& fn) {
+    if (count == 0) return;
+
+    // Small jobs, single-threaded pools and nested calls run inline
+    if (workers.empty() || count == 1 || insidePoolTask) {
+        for (std::size_t i = 0; i < count; ++i) fn(i);
+        return;
+    }
+
+    std::lock_guard<std::mutex> submit(submitMutex);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        task = &fn;
+        taskCount = count;
+        nextTask.store(0);
+        firstError = nullptr;
+        workersDone = 0;
+        ++generation;
+    }
+    wakeWorkers.notify_all();
+
+    runTasks();
+
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        jobDone.wait(lock, [&] { return workersDone == workers.size(); });
+        task = nullptr;
+        error = firstError;
+    }
+    if (error) std::rethrow_exception(error);
+}
@@ -0,0 +1,61 @@
+#include "TickerIndex.hpp"
+
+namespace {
+    constexpr std::size_t MIN_SLOTS = 16;
+}
+
+std::uint64_t TickerIndex::hashOf(std::string_view ticker) {
+    // FNV-1a, then a final mix so the low bits used for the slot depend on
+    // every character (tickers share long common prefixes)
+    std::uint64_t h = 14695981039346656037ull;
+    for (char c : ticker) {
+        h ^= static_cast<unsigned char>(c);
+        h *= 1099511628211ull;
+    }
+    h ^= h >> 32;
+    h *= 0x9E3779B97F4A7C15ull;
+    return h ^ (h >> 29);
+}
+
+void TickerIndex::rehash(std::size_t slotCount) {
+    slots.assign(slotCount, Slot{0, INVALID_INSTRUMENT});
+    const std::size_t mask = slotCount - 1;
+    for (InstrumentId id = 0; id < tickers.size(); ++id) {
+        std::uint64_t h = hashOf(tickers[id]);
+        std::size_t i = static_cast<std::size_t>(h) & mask;
+        while (slots[i].id != INVALID_INSTRUMENT) i = (i + 1) & mask;
+        slots[i] = {h, id};
+    }
+}
+
+InstrumentId TickerIndex::find(std::string_view ticker) const {
+    if (slots.empty()) return INVALID_INSTRUMENT;
+
+    const std::size_t mask = slots.size() - 1;
+    std::uint64_t h = hashOf(ticker);
+    for (std::size_t i = static_cast<std::size_t>(h) & mask;; i = (i + 1) & mask) {
+        const Slot& slot = slots[i];
+        if (slot.id == INVALID_INSTRUMENT) return INVALID_INSTRUMENT;
+        if (slot.hash == h && tickers[slot.id] == ticker) return slot.id;
+    }
+}
+
+InstrumentId TickerIndex::intern(std::string_view ticker) {
+    InstrumentId existing = find(ticker);
+    if (existing != INVALID_INSTRUMENT) return existing;
+
+    // Keep the table at most half full so probe runs stay short
+    InstrumentId id = static_cast<InstrumentId>(tickers.size());
+    tickers.emplace_back(ticker);
+    if (2 * tickers.size() > slots.size()) {
+        rehash(slots.empty() ? MIN_SLOTS : 2 * slots.size());
+        return id;
+    }
+
+    const std::size_t mask = slots.size() - 1;
+    std::uint64_t h = hashOf(ticker);
+    std::size_t i = static_cast<std::size_t>(h) & mask;
+    while (slots[i].id != INVALID_INSTRUMENT) i = (i + 1) & mask;
+    slots[i] = {h, id};
+    return id;
+}
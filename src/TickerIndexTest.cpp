@@ -0,0 +1,73 @@
+// Ticker interning: dense stable ids across every rehash, and lookups of
+// absent tickers (near misses included) ending on an empty slot
+#include "TestSupport.hpp"
+#include "TickerIndex.hpp"
+#include <algorithm>
+#include <cctype>
+#include <vector>
+
+namespace {
+    constexpr std::size_t TICKERS = 100000;
+
+    // Generator-style tickers: long shared prefixes, differing in a few characters
+    std::string ticker(std::size_t i) {
+        static const char* suffixes[] = {"", "_FRN", "_ZERO"};
+        return "BOND_" + std::to_string(i + 1) + "_" + std::to_string(2 + i % 29) + "Y" + suffixes[i % 3];
+    }
+
+    bool isPowerOfTwo(std::size_t n) { return n != 0 && (n & (n - 1)) == 0; }
+}
+
+int main() {
+    TickerIndex index;
+
+    // 1. Nothing is found in an empty index
+    expectTrue("empty index finds nothing", index.find(ticker(0)) == INVALID_INSTRUMENT);
+    expectTrue("empty index finds no empty ticker", index.find("") == INVALID_INSTRUMENT);
+
+    // 2. Ids are dense in registration order. The table doubles whenever it
+    //    would pass half full, so right after each growth every ticker
+    //    interned so far must still resolve to its id.
+    bool stable = true;
+    for (std::size_t i = 0; i < TICKERS; ++i) {
+        InstrumentId id = index.intern(ticker(i));
+        expectTrue("dense id for " + ticker(i), id == i);
+
+        if (isPowerOfTwo(index.size() - 1)) {
+            for (std::size_t j = 0; j <= i; ++j) {
+                if (index.find(ticker(j)) != j) stable = false;
+            }
+        }
+    }
+    expectTrue("ids survive every rehash", stable);
+    expectTrue("size", index.size() == TICKERS);
+
+    // 3. Interning again returns the existing id and adds nothing, also
+    //    for a view into the index's own storage
+    bool reused = true;
+    for (std::size_t i = 0; i < TICKERS; i += 97) {
+        if (index.intern(ticker(i)) != i) reused = false;
+        if (index.intern(index.getTicker(static_cast<InstrumentId>(i))) != i) reused = false;
+        if (index.getTicker(static_cast<InstrumentId>(i)) != ticker(i)) reused = false;
+    }
+    expectTrue("re-interning keeps ids and tickers", reused);
+    expectTrue("re-interning adds nothing", index.size() == TICKERS);
+
+    // 4. Absent tickers, including prefixes, extensions and case changes of
+    //    registered ones, are not found and are not registered by find
+    const std::string near = ticker(41);
+    std::string lower = near;
+    std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return std::tolower(c); });
+    for (const std::string& absent : {std::string(), near.substr(0, near.size() - 1), near + "X",
+                                      lower, ticker(TICKERS), ticker(TICKERS + 1)}) {
+        expectTrue("absent ticker '" + absent + "'", index.find(absent) == INVALID_INSTRUMENT);
+    }
+    std::size_t found = 0;
+    for (std::size_t i = TICKERS; i < 3 * TICKERS; ++i) {
+        if (index.find(ticker(i)) != INVALID_INSTRUMENT) ++found;
+    }
+    expectTrue("no absent ticker found", found == 0);
+    expectTrue("find registers nothing", index.size() == TICKERS);
+
+    return testResult("Ticker ids are dense, stable across rehashes, and absent tickers miss");
+}
@@ -0,0 +1,158 @@
+#include "TradeIngestor.hpp"
+#include <chrono>
+
+namespace {
+    // Empty polls before the book thread starts yielding, then sleeping
+    constexpr unsigned SPIN_POLLS = 64;
+    constexpr unsigned YIELD_POLLS = 1024;
+    constexpr auto IDLE_SLEEP = std::chrono::microseconds(50);
+}
+
+TradeIngestor::TradeIngestor(TradingBook& book, std::size_t queueCapacity, std::size_t batchSize)
+    : book(book), queue(queueCapacity), batchSize(batchSize > 0 ? batchSize : 1),
+      published(new SharedPosition[book.getPositions().size()]),
+      instrumentCount(book.getPositions().size()) {
+    // Start from the book as it stands
+    const std::vector<Position>& positions = book.getPositions();
+    for (std::size_t id = 0; id < instrumentCount; ++id) {
+        published[id].quantity.store(positions[id].quantity, std::memory_order_relaxed);
+        published[id].averageCost.store(positions[id].averageCost, std::memory_order_relaxed);
+        published[id].realizedPnL.store(positions[id].realizedPnL, std::memory_order_relaxed);
+    }
+    publishedSpreadPnL.store(book.getSpreadPnL(), std::memory_order_relaxed);
+
+    writer = std::thread(&TradeIngestor::writerLoop, this);
+}
+
+TradeIngestor::~TradeIngestor() {
+    stop();
+}
+
+bool TradeIngestor::trySubmit(const Trade& trade, double midPrice) {
+    return queue.tryPush({trade, midPrice});
+}
+
+void TradeIngestor::submit(const Trade& trade, double midPrice) {
+    while (!trySubmit(trade, midPrice)) {
+        std::this_thread::yield(); // Queue full: let the book thread catch up
+    }
+}
+
+void TradeIngestor::flush() {
+    // Ticket: the producers' claim position. A fill whose push has returned
+    // is below it even if a racing producer has claimed but not yet written
+    // an earlier slot; the book thread waits for that slot, so reaching the
+    // ticket means everything before it has been applied
+    std::uint64_t ticket = queue.claimed();
+    while (applied.load(std::memory_order_acquire) < ticket) {
+        std::this_thread::yield();
+    }
+}
+
+void TradeIngestor::stop() {
+    if (!writer.joinable()) return;
+    flush();
+    running.store(false, std::memory_order_release);
+    writer.join();
+}
+
+void TradeIngestor::writerLoop() {
+    std::vector<InstrumentId> touched;
+    std::vector<char> isTouched(instrumentCount, 0);
+    std::uint64_t tradesApplied = 0;
+    unsigned idlePolls = 0;
+    TradeFill fill;
+
+    for (;;) {
+        // 1. Drain up to one batch into the book
+        std::size_t drained = 0;
+        while (drained < batchSize && queue.tryPop(fill)) {
+            ++drained;
+            InstrumentId id = fill.trade.instrument;
+            if (id >= instrumentCount) {
+                rejected.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            book.applyTrade(fill.trade, fill.midPrice);
+            ++tradesApplied;
+            if (!isTouched[id]) {
+                isTouched[id] = 1;
+                touched.push_back(id);
+            }
+        }
+
+        // 2. Publish the lines the batch changed, then release it to flush()
+        if (drained > 0) {
+            publish(touched, tradesApplied);
+            for (InstrumentId id : touched) isTouched[id] = 0;
+            touched.clear();
+            applied.fetch_add(drained, std::memory_order_release);
+            idlePolls = 0;
+            continue;
+        }
+
+        // 3. Idle: stop() flushes before clearing running, so nothing is left
+        if (!running.load(std::memory_order_acquire)) break;
+        if (++idlePolls < SPIN_POLLS) continue;
+        if (idlePolls < YIELD_POLLS) std::this_thread::yield();
+        else std::this_thread::sleep_for(IDLE_SLEEP);
+    }
+}
+
+void TradeIngestor::publish(const std::vector<InstrumentId>& touched, std::uint64_t tradesApplied) {
+    const std::vector<Position>& positions = book.getPositions();
+
+    // Seqlock write: odd sequence while the mirror is being updated
+    std::uint64_t seq = sequence.load(std::memory_order_relaxed);
+    sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (InstrumentId id : touched) {
+        published[id].quantity.store(positions[id].quantity, std::memory_order_relaxed);
+        published[id].averageCost.store(positions[id].averageCost, std::memory_order_relaxed);
+        published[id].realizedPnL.store(positions[id].realizedPnL, std::memory_order_relaxed);
+    }
+    publishedSpreadPnL.store(book.getSpreadPnL(), std::memory_order_relaxed);
+    publishedTrades.store(tradesApplied, std::memory_order_relaxed);
+
+    sequence.store(seq + 2, std::memory_order_release);
+}
+
+PositionSnapshot TradeIngestor::readPosition(InstrumentId id) const {
+    PositionSnapshot out;
+    if (id >= instrumentCount) return out;
+
+    const SharedPosition& p = published[id];
+    for (;;) {
+        std::uint64_t before = sequence.load(std::memory_order_acquire);
+        if (before & 1) {
+            std::this_thread::yield();
+            continue;
+        }
+        out.quantity = p.quantity.load(std::memory_order_relaxed);
+        out.averageCost = p.averageCost.load(std::memory_order_relaxed);
+        out.realizedPnL = p.realizedPnL.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence.load(std::memory_order_relaxed) == before) return out;
+    }
+}
+
+void TradeIngestor::snapshot(BookSnapshot& out) const {
+    out.positions.resize(instrumentCount);
+    for (;;) {
+        std::uint64_t before = sequence.load(std::memory_order_acquire);
+        if (before & 1) {
+            std::this_thread::yield();
+            continue;
+        }
+        for (std::size_t id = 0; id < instrumentCount; ++id) {
+            out.positions[id].quantity = published[id].quantity.load(std::memory_order_relaxed);
+            out.positions[id].averageCost = published[id].averageCost.load(std::memory_order_relaxed);
+            out.positions[id].realizedPnL = published[id].realizedPnL.load(std::memory_order_relaxed);
+        }
+        out.realizedSpreadPnL = publishedSpreadPnL.load(std::memory_order_relaxed);
+        out.tradesApplied = publishedTrades.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence.load(std::memory_order_relaxed) == before) return;
+    }
+}
@@ -0,0 +1,46 @@
+#include "TradeQueue.hpp"
+#include <cstdint>
+
+TradeQueue::TradeQueue(std::size_t capacity) {
+    std::size_t size = 2;
+    while (size < capacity) size *= 2;
+
+    cells.reset(new Cell[size]);
+    mask = size - 1;
+    for (std::size_t i = 0; i < size; ++i) {
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool TradeQueue::tryPush(const TradeFill& fill) {
+    std::size_t pos = tail.load(std::memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+        cell = &cells[pos & mask];
+        std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+        std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+
+        if (diff == 0) {
+            // Cell is free for lap pos: claim it
+            if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            return false; // Still holds an unread fill from the previous lap
+        } else {
+            pos = tail.load(std::memory_order_relaxed); // Another producer got there first
+        }
+    }
+
+    cell->fill = fill;
+    cell->sequence.store(pos + 1, std::memory_order_release); // Hand over to the consumer
+    return true;
+}
+
+bool TradeQueue::tryPop(TradeFill& out) {
+    Cell& cell = cells[head & mask];
+    if (cell.sequence.load(std::memory_order_acquire) != head + 1) return false;
+
+    out = cell.fill;
+    cell.sequence.store(head + mask + 1, std::memory_order_release); // Free for the next lap
+    ++head;
+    return true;
+}
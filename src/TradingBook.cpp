@@ -1,5 +1,14 @@
 #include "TradingBook.hpp"
+#include "PortfolioPricer.hpp"
+#include "ThreadPool.hpp"
+#include "Logger.hpp"
 #include <iomanip>
+#include <algorithm>
+
+namespace {
+    // Positions marked per pool task, so a task is worth its scheduling cost
+    constexpr std::size_t MARK_CHUNK = 1024;
+}
 
 // Position Logic
 
@@ -66,6 +75,12 @@ double Position::getTotalPV01(const YieldCurve& market) const {
     return quantity * unitPV01;
 }
 
+std::vector<double> Position::getKeyRatePV01(const YieldCurve& market) const {
+    std::vector<double> keyRates = RiskEngine::calculateKeyRatePV01(*instrument, market);
+    for (double& k : keyRates) k *= quantity;
+    return keyRates;
+}
+
 double Position::getUnrealizedPnL(const YieldCurve& market) const {
     double currentPrice = instrument->calculatePrice(market);
     // (Market Price - Avg Cost) * Quantity
@@ -77,33 +92,42 @@ double Position::getUnrealizedPnL(const YieldCurve& market) const {
 // TradingBook Logic
 // =======================
 
-double TradingBook::getPosition(const std::string &ticker) const
-{
-    auto it = positions.find(ticker);
-    if (it != positions.end())
+InstrumentId TradingBook::addKnownInstrument(Instrument instrument) {
+    InstrumentId id = tickerIndex.intern(asBond(instrument).getTicker());
+    if (id == positions.size())
     {
-        return it->second.quantity;
+        // New ticker: move the bond into the registry (same id) and create
+        // an empty position for it
+        instruments.add(std::move(instrument));
+        positions.emplace_back(instruments.getBond(id));
+        markedVersion = 0; // No unit price or PV01 yet: the next mark reprices everything
+        Logger::instance().log(LogLevel::Info, LogEvent::InstrumentRegistered, tickerIndex.getTicker(id));
     }
-    return 0.0;
+    return id;
 }
 
-void TradingBook::addKnownInstrument(std::shared_ptr<Bond> bond) {
-    // Create an empty position for this bond
-    if (positions.find(bond->getTicker()) == positions.end())
-    {
-        positions.emplace(bond->getTicker(), Position(bond));
-        std::cout << "Registered Instrument: " << bond->getTicker() << std::endl;
-    }
+InstrumentId TradingBook::addKnownInstrument(const std::shared_ptr<Bond>& bond) {
+    InstrumentId id = getInstrumentId(bond->getTicker());
+    if (id != INVALID_INSTRUMENT) return id; // Known: skip the copy
+    return addKnownInstrument(toInstrument(*bond));
 }
 
 void TradingBook::bookTrade(const Trade &trade, double midPrice) {
-    auto it = positions.find(trade.bondName);
-    if (it == positions.end())
+    if (trade.instrument >= positions.size())
     {
-        std::cerr << "Error: Bond not found." << std::endl;
+        Logger::instance().log(LogLevel::Error, LogEvent::UnknownInstrument, {}, trade.instrument);
         return;
     }
 
+    double edgeCaptured = applyTrade(trade, midPrice);
+
+    Logger::instance().log(LogLevel::Info, LogEvent::TradeBooked, tickerIndex.getTicker(trade.instrument),
+                           trade.quantity, trade.price, midPrice, edgeCaptured);
+}
+
+double TradingBook::applyTrade(const Trade &trade, double midPrice) {
+    Position& position = positions[trade.instrument];
+
     // 1. Calculate
     double edgeCaptured = 0.0;
 
@@ -123,16 +147,101 @@ void TradingBook::bookTrade(const Trade &trade, double midPrice) {
 
     // 3. Update Metrics
     realizedSpreadPnL += edgeCaptured;
-    it->second.addTrade(trade); // Accounting update
 
-    std::cout << "[TRADE] " << (trade.quantity > 0 ? "BUY " : "SELL ")
-            << std::abs(trade.quantity) << " of " << trade.bondName
-            << " @ " << trade.price
-            << " (Mid: " << midPrice << ")"
-            << " | Edge Captured: " << edgeCaptured << std::endl;
+    // Accounting update, and the position's change in the book totals
+    BookRisk before = position.getCachedRisk();
+    position.addTrade(trade);
+    if (markedVersion != 0) {
+        BookRisk after = position.getCachedRisk();
+        bookRisk.marketValue += after.marketValue - before.marketValue;
+        bookRisk.unrealizedPnL += after.unrealizedPnL - before.unrealizedPnL;
+        bookRisk.pv01 += after.pv01 - before.pv01;
+    }
+    return edgeCaptured;
 }
 
-void TradingBook::printRiskReport(const YieldCurve& market) const {
+void TradingBook::remarkAll(const YieldCurve& market) {
+    // 1. Unit price and PV01 of every instrument (flat ones too, so the next
+    //    trade in them can be applied incrementally). estimatedErrors[i] < 0
+    //    marks an exact reprice.
+    std::vector<double> estimatedErrors(positions.size(), -1.0);
+    auto mark = [&](std::size_t i) {
+        Position& pos = positions[i];
+
+        if (fastMark && pos.baseAnchorVersion == market.getAnchorVersion()) {
+            const Sensitivities& base = pos.baseSensitivities;
+            double dy = (market.getShiftFromAnchor() - pos.baseShiftBps) * 1e-4;
+            double error = std::abs(base.thirdDerivative * dy * dy * dy) / 6.0;
+
+            if (error <= fastMarkTolerance) {
+                double d1 = base.pv01 * 1e4;             // dP/dy
+                double d2 = base.convexity * base.price; // d2P/dy2
+                pos.unitPrice = base.price + dy * (d1 + 0.5 * dy * d2);
+                pos.unitPV01 = (d1 + dy * (d2 + 0.5 * dy * base.thirdDerivative)) * 1e-4;
+                estimatedErrors[i] = error;
+                return;
+            }
+        }
+
+        Sensitivities sens = RiskEngine::calculateSensitivities(*pos.instrument, market);
+        pos.unitPrice = sens.price;
+        pos.unitPV01 = sens.pv01;
+        pos.baseSensitivities = sens;
+        pos.baseAnchorVersion = market.getAnchorVersion();
+        pos.baseShiftBps = market.getShiftFromAnchor();
+    };
+
+    std::size_t tasks = (positions.size() + MARK_CHUNK - 1) / MARK_CHUNK;
+    ThreadPool::instance().parallelFor(tasks, [&](std::size_t task) {
+        std::size_t end = std::min(positions.size(), (task + 1) * MARK_CHUNK);
+        for (std::size_t i = task * MARK_CHUNK; i < end; ++i) {
+            mark(i);
+        }
+    });
+
+    fastMarkStats = FastMarkStats{};
+    for (double error : estimatedErrors) {
+        if (error < 0.0) {
+            ++fastMarkStats.repriced;
+        } else {
+            ++fastMarkStats.approximated;
+            fastMarkStats.maxEstimatedError = std::max(fastMarkStats.maxEstimatedError, error);
+        }
+    }
+
+    // 2. Totals, summed in book order
+    bookRisk = BookRisk{};
+    for (const Position& pos : positions) {
+        BookRisk r = pos.getCachedRisk();
+        bookRisk.marketValue += r.marketValue;
+        bookRisk.unrealizedPnL += r.unrealizedPnL;
+        bookRisk.pv01 += r.pv01;
+    }
+
+    markedVersion = market.getVersion();
+}
+
+void TradingBook::setFastMark(bool enabled, double tolerance) {
+    fastMark = enabled;
+    fastMarkTolerance = tolerance;
+}
+
+void TradingBook::markToMarket(const YieldCurve& market) {
+    if (market.getVersion() != markedVersion) {
+        remarkAll(market);
+    }
+}
+
+const BookRisk& TradingBook::getBookRisk(const YieldCurve& market) {
+    markToMarket(market);
+    return bookRisk;
+}
+
+void TradingBook::printRiskReport(const YieldCurve& market) {
+    // Only reprices if the curve moved since the last mark
+    markToMarket(market);
+    Logger::instance().flush(); // Keep the report after the trades logged before it
+
     std::cout << "\n================ MARKET MAKER RISK BLOTTER ================" << std::endl;
     std::cout << std::left << std::setw(20) << "Bond"
               << std::right << std::setw(10) << "Net Qty"
@@ -142,28 +251,60 @@ void TradingBook::printRiskReport(const YieldCurve& market) const {
               << std::setw(12) << "Total PV01" << std::endl;
     std::cout << "-------------------------------------------------------------------------------" << std::endl;
 
-    double totalPnL = 0;
-    double totalRisk = 0;
-
-    for (const auto& [name, pos] : positions) {
+    for (InstrumentId id = 0; id < positions.size(); ++id) {
+        const Position& pos = positions[id];
         if (pos.quantity == 0) continue; // Skip flat positions
 
-        double price = pos.instrument->calculatePrice(market);
-        double unrlzd = pos.getUnrealizedPnL(market);
-        double risk = pos.getTotalPV01(market);
-
-        totalPnL += unrlzd;
-        totalRisk += risk;
-
-        std::cout << std::left << std::setw(20) << name
+        BookRisk risk = pos.getCachedRisk();
+        std::cout << std::left << std::setw(20) << tickerIndex.getTicker(id)
                   << std::right << std::setw(10) << pos.quantity
-                  << std::setw(12) << std::fixed << std::setprecision(2) << price
+                  << std::setw(12) << std::fixed << std::setprecision(2) << pos.unitPrice
                   << std::setw(12) << pos.averageCost
-                  << std::setw(12) << unrlzd
-                  << std::setw(12) << risk << std::endl;
+                  << std::setw(12) << risk.unrealizedPnL
+                  << std::setw(12) << risk.pv01 << std::endl;
     }
     std::cout << "-------------------------------------------------------------------------------" << std::endl;
-    std::cout << "TOTAL BOOK P&L (Unrealized): " << totalPnL << std::endl;
-    std::cout << "TOTAL BOOK RISK (PV01):      " << totalRisk << " (Loss if rates +1bp)" << std::endl;
+    std::cout << "TOTAL BOOK P&L (Unrealized): " << bookRisk.unrealizedPnL << std::endl;
+    std::cout << "TOTAL BOOK RISK (PV01):      " << bookRisk.pv01 << " (Loss if rates +1bp)" << std::endl;
     std::cout << "===============================================================================\n" << std::endl;
 }
+
+std::vector<double> TradingBook::getKeyRatePV01(const YieldCurve& market) const {
+    return PortfolioPricer(*this).bookKeyRatePV01(market);
+}
+
+void TradingBook::printKeyRateReport(const YieldCurve& market) const {
+    const std::vector<double>& pillars = market.getPillarTimes();
+    const std::size_t width = 20 + 10 * pillars.size();
+    Logger::instance().flush();
+
+    std::cout << "\n================ KEY RATE PV01 ================" << std::endl;
+    std::cout << std::left << std::setw(20) << "Bond" << std::right;
+    for (double t : pillars) {
+        std::cout << std::setw(9) << std::defaultfloat << t << "Y";
+    }
+    std::cout << std::endl << std::string(width, '-') << std::endl;
+
+    PortfolioPricer portfolio(*this);
+    std::vector<double> lineKeyRates;
+    portfolio.keyRatePV01(market, lineKeyRates);
+
+    std::vector<double> total(pillars.size(), 0.0);
+    for (std::size_t i = 0; i < portfolio.lineCount(); ++i) {
+        std::cout << std::left << std::setw(20) << portfolio.getInstrument(i).getTicker()
+                  << std::right << std::fixed << std::setprecision(2);
+        for (std::size_t k = 0; k < pillars.size(); ++k) {
+            double risk = portfolio.getQuantity(i) * lineKeyRates[i * pillars.size() + k];
+            total[k] += risk;
+            std::cout << std::setw(10) << risk;
+        }
+        std::cout << std::endl;
+    }
+
+    std::cout << std::string(width, '-') << std::endl;
+    std::cout << std::left << std::setw(20) << "TOTAL" << std::right;
+    for (double risk : total) {
+        std::cout << std::setw(10) << risk;
+    }
+    std::cout << std::endl << std::string(width, '=') << "\n" << std::endl;
+}
@@ -0,0 +1,189 @@
+#include "VaREngine.hpp"
+#include "Philox.hpp"
+#include "TradingBook.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+    // (1 - confidence) * N is rarely exact in binary: 0.99 over 10000
+    // scenarios gives 100.00000000000009, which must not round up to 101
+    constexpr double TAIL_EPSILON = 1e-9;
+}
+
+VaREngine::VaREngine(ThreadPool& pool, std::size_t batchSize)
+    : pool(pool), batchSize(batchSize > 0 ? batchSize : 1) {}
+
+std::vector<double> VaREngine::scenarioPnL(const PortfolioPricer& portfolio, const YieldCurve& baseCurve,
+                                           const std::vector<CurveScenario>& scenarios) const
+{
+    // Base value with the same sweep, so P&L has no pricing-path noise
+    std::vector<double> prices;
+    portfolio.priceLines(baseCurve, prices);
+    double baseValue = 0.0;
+    for (std::size_t i = 0; i < prices.size(); ++i) baseValue += portfolio.getQuantity(i) * prices[i];
+
+    std::vector<double> pnl(scenarios.size());
+    std::size_t batches = (scenarios.size() + batchSize - 1) / batchSize;
+
+    pool.parallelFor(batches, [&](std::size_t batch) {
+        // One curve and price buffer per batch
+        YieldCurve shocked;
+        std::vector<double> linePrices(portfolio.lineCount());
+
+        std::size_t begin = batch * batchSize;
+        std::size_t end = std::min(begin + batchSize, scenarios.size());
+        for (std::size_t s = begin; s < end; ++s)
+        {
+            shocked.assignShocked(baseCurve, scenarios[s]);
+            portfolio.priceLines(shocked, 0, portfolio.lineCount(), linePrices.data(), nullptr);
+
+            double value = 0.0;
+            for (std::size_t i = 0; i < linePrices.size(); ++i) value += portfolio.getQuantity(i) * linePrices[i];
+            pnl[s] = value - baseValue;
+        }
+    });
+    return pnl;
+}
+
+VaRResult VaREngine::fromPnL(std::vector<double> pnl, double confidence)
+{
+    VaRResult result;
+    result.confidence = confidence;
+    result.scenarioPnL = pnl;
+    if (pnl.empty()) return result;
+
+    // Worst (1 - confidence) share of scenarios forms the tail
+    std::sort(pnl.begin(), pnl.end());
+    double tailShare = (1.0 - confidence) * static_cast<double>(pnl.size());
+    std::size_t tail = static_cast<std::size_t>(std::ceil(tailShare - TAIL_EPSILON * std::max(tailShare, 1.0)));
+    tail = std::min(std::max<std::size_t>(tail, 1), pnl.size());
+
+    double tailSum = 0.0;
+    for (std::size_t i = 0; i < tail; ++i) tailSum += pnl[i];
+
+    result.valueAtRisk = -pnl[tail - 1];
+    result.expectedShortfall = -tailSum / static_cast<double>(tail);
+    return result;
+}
+
+VaRResult VaREngine::compute(const PortfolioPricer& portfolio, const YieldCurve& baseCurve,
+                             const std::vector<CurveScenario>& scenarios, double confidence) const
+{
+    return fromPnL(scenarioPnL(portfolio, baseCurve, scenarios), confidence);
+}
+
+VaRResult VaREngine::compute(const TradingBook& book, const YieldCurve& baseCurve,
+                             const std::vector<CurveScenario>& scenarios, double confidence) const
+{
+    return compute(PortfolioPricer(book), baseCurve, scenarios, confidence);
+}
+
+std::vector<CurveScenario> VaREngine::loadHistoricalScenarios(const std::string& path, std::size_t pillarCount)
+{
+    std::ifstream in(path);
+    if (!in)
+    {
+        throw std::runtime_error("VaREngine: cannot open scenario file " + path);
+    }
+
+    std::vector<CurveScenario> scenarios;
+    std::string line;
+    std::size_t lineNumber = 0;
+    while (std::getline(in, line))
+    {
+        ++lineNumber;
+        if (line.empty() || line[0] == '#') continue;
+
+        CurveScenario scenario;
+        std::stringstream ss(line);
+        std::string cell;
+        while (std::getline(ss, cell, ','))
+        {
+            // The whole field must be the number ("1.5abc" is rejected);
+            // surrounding whitespace, e.g. a CRLF line ending, is allowed
+            std::size_t parsed = 0;
+            double value = 0.0;
+            try
+            {
+                value = std::stod(cell, &parsed);
+            }
+            catch (const std::exception&)
+            {
+                parsed = 0;
+            }
+            if (parsed == 0 || cell.find_first_not_of(" \t\r", parsed) != std::string::npos)
+            {
+                throw std::runtime_error("VaREngine: bad value '" + cell + "' on line " + std::to_string(lineNumber));
+            }
+            scenario.push_back(value);
+        }
+
+        if (scenario.size() != pillarCount)
+        {
+            throw std::runtime_error("VaREngine: line " + std::to_string(lineNumber) + " has " +
+                                     std::to_string(scenario.size()) + " columns, expected " +
+                                     std::to_string(pillarCount));
+        }
+        scenarios.push_back(std::move(scenario));
+    }
+    return scenarios;
+}
+
+std::vector<CurveScenario> VaREngine::simulateScenarios(const std::vector<double>& volsBps,
+                                                        const std::vector<std::vector<double>>& correlation,
+                                                        std::size_t count, std::uint64_t seed)
+{
+    const std::size_t n = volsBps.size();
+    if (correlation.size() != n)
+    {
+        throw std::invalid_argument("VaREngine: correlation matrix size does not match vols");
+    }
+
+    // 1. Cholesky factor (lower triangular) of the correlation matrix
+    std::vector<double> chol(n * n, 0.0);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (correlation[i].size() != n)
+        {
+            throw std::invalid_argument("VaREngine: correlation matrix is not square");
+        }
+        for (std::size_t j = 0; j <= i; ++j)
+        {
+            double sum = correlation[i][j];
+            for (std::size_t k = 0; k < j; ++k) sum -= chol[i * n + k] * chol[j * n + k];
+
+            if (i == j)
+            {
+                if (sum <= 0.0)
+                {
+                    throw std::invalid_argument("VaREngine: correlation matrix is not positive definite");
+                }
+                chol[i * n + i] = std::sqrt(sum);
+            }
+            else
+            {
+                chol[i * n + j] = sum / chol[j * n + j];
+            }
+        }
+    }
+
+    // 2. Correlated shocks, one counter-based stream per scenario
+    std::vector<CurveScenario> scenarios(count, CurveScenario(n, 0.0));
+    std::vector<double> z(n);
+    for (std::size_t s = 0; s < count; ++s)
+    {
+        PhiloxStream rng(seed, s);
+        for (double& zi : z) zi = rng.normal();
+
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            double shock = 0.0;
+            for (std::size_t k = 0; k <= i; ++k) shock += chol[i * n + k] * z[k];
+            scenarios[s][i] = shock * volsBps[i];
+        }
+    }
+    return scenarios;
+}
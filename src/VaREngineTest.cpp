@@ -0,0 +1,139 @@
+// VaR / ES on known P&L samples, strict scenario file parsing, the
+// Cholesky scenario simulation, and full revaluation against per-bond repricing
+#include "Philox.hpp"
+#include "PortfolioGenerator.hpp"
+#include "TestSupport.hpp"
+#include "VaREngine.hpp"
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+    constexpr double TOLERANCE = 1e-9;
+    constexpr const char* SCENARIO_FILE = "VaREngineTest_scenarios.csv";
+
+    // P&L of first + k for k = 0..count-1, in a scrambled order
+    std::vector<double> ladder(std::size_t count, double first) {
+        std::vector<double> pnl(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            pnl[i] = first + static_cast<double>((i * 7919) % count); // 7919 is prime to every count used
+        }
+        return pnl;
+    }
+
+    // VaR is the tail-th worst loss and ES the mean of the tail worst
+    void checkLadder(const std::string& what, std::size_t count, double confidence, std::size_t tail) {
+        const double first = -5000.0;
+        VaRResult r = VaREngine::fromPnL(ladder(count, first), confidence);
+        double worst = first + static_cast<double>(tail - 1);
+        expectNear(what + " VaR", r.valueAtRisk, -worst, TOLERANCE);
+        expectNear(what + " ES", r.expectedShortfall, -(first + worst) / 2.0, TOLERANCE);
+        expectTrue(what + " keeps scenario order", r.scenarioPnL == ladder(count, first));
+    }
+
+    // Writes the file and reports whether loading it throws std::runtime_error
+    bool rejects(const std::string& contents, std::size_t pillarCount) {
+        std::ofstream(SCENARIO_FILE) << contents;
+        try {
+            VaREngine::loadHistoricalScenarios(SCENARIO_FILE, pillarCount);
+        } catch (const std::runtime_error&) {
+            return true;
+        }
+        return false;
+    }
+}
+
+int main() {
+    // 1. Tail size at and around exact (1 - c) * N: 0.99 * 10000 is
+    //    100.00000000000009 in binary and must still give 100 scenarios
+    checkLadder("99% of 10000", 10000, 0.99, 100);
+    checkLadder("97.5% of 1000", 1000, 0.975, 25);
+    checkLadder("99% of 150", 150, 0.99, 2); // 1.5 rounds up
+    checkLadder("99% of 50", 50, 0.99, 1);   // At least one scenario
+    checkLadder("0% of 10", 10, 0.0, 10);    // Whole sample
+
+    // 2. Scenario files: comments, blank lines, spaces and CRLF are fine
+    std::ofstream(SCENARIO_FILE) << "# 1Y,5Y,10Y,30Y\n1,2,3,4\n\n-1.5, 0 ,2e1,-3\r\n";
+    std::vector<CurveScenario> loaded = VaREngine::loadHistoricalScenarios(SCENARIO_FILE, TEST_PILLAR_COUNT);
+    expectTrue("scenario file rows", loaded.size() == 2);
+    if (loaded.size() == 2) {
+        expectTrue("scenario file values",
+                   loaded[0] == CurveScenario{1, 2, 3, 4} && loaded[1] == CurveScenario{-1.5, 0, 20, -3});
+    }
+
+    // ... and anything that is not a whole number, or the wrong width, is rejected
+    expectTrue("trailing text rejected", rejects("1,2,1.5abc,4\n", TEST_PILLAR_COUNT));
+    expectTrue("empty field rejected", rejects("1,,3,4\n", TEST_PILLAR_COUNT));
+    expectTrue("text rejected", rejects("1,2,three,4\n", TEST_PILLAR_COUNT));
+    expectTrue("short row rejected", rejects("1,2,3\n", TEST_PILLAR_COUNT));
+    expectTrue("long row rejected", rejects("1,2,3,4,5\n", TEST_PILLAR_COUNT));
+    std::remove(SCENARIO_FILE);
+    try {
+        VaREngine::loadHistoricalScenarios(SCENARIO_FILE, TEST_PILLAR_COUNT);
+        fail("missing file accepted");
+    } catch (const std::runtime_error&) {
+    }
+
+    // 3. Two pillars: shock = vol * (z0, rho * z0 + sqrt(1 - rho^2) * z1),
+    //    drawn from Philox stream (seed, scenario)
+    const double rho = 0.6;
+    const std::vector<double> vols = {5.0, 8.0};
+    std::vector<CurveScenario> simulated = VaREngine::simulateScenarios(vols, {{1.0, rho}, {rho, 1.0}}, 1000, 42);
+    expectTrue("simulated count", simulated.size() == 1000);
+    for (std::size_t s = 0; s < simulated.size(); ++s) {
+        PhiloxStream rng(42, s);
+        double z0 = rng.normal();
+        double z1 = rng.normal();
+        expectNear("shock 0 of scenario " + std::to_string(s), simulated[s][0], vols[0] * z0, TOLERANCE);
+        expectNear("shock 1 of scenario " + std::to_string(s), simulated[s][1],
+                   vols[1] * (rho * z0 + std::sqrt(1.0 - rho * rho) * z1), TOLERANCE);
+    }
+
+    // ... and over many scenarios the sample moments match the inputs
+    const std::vector<double> curveVols = {6.0, 7.0, 6.5, 5.5};
+    std::vector<std::vector<double>> correlation(TEST_PILLAR_COUNT, std::vector<double>(TEST_PILLAR_COUNT));
+    for (std::size_t i = 0; i < TEST_PILLAR_COUNT; ++i)
+        for (std::size_t j = 0; j < TEST_PILLAR_COUNT; ++j)
+            correlation[i][j] = std::exp(-std::abs(TEST_PILLAR_TIMES[i] - TEST_PILLAR_TIMES[j]) / 15.0);
+
+    const std::size_t draws = 50000;
+    std::vector<CurveScenario> sample = VaREngine::simulateScenarios(curveVols, correlation, draws, 7);
+    for (std::size_t i = 0; i < TEST_PILLAR_COUNT; ++i) {
+        for (std::size_t j = 0; j <= i; ++j) {
+            double covariance = 0.0;
+            for (const CurveScenario& s : sample) covariance += s[i] * s[j];
+            covariance /= static_cast<double>(draws);
+            // Sampling error of a covariance is about vol_i * vol_j / sqrt(draws)
+            expectNear("covariance " + std::to_string(i) + "," + std::to_string(j), covariance,
+                       correlation[i][j] * curveVols[i] * curveVols[j],
+                       5.0 * curveVols[i] * curveVols[j] / std::sqrt(static_cast<double>(draws)));
+        }
+    }
+    expectTrue("same seed, same scenarios", VaREngine::simulateScenarios(curveVols, correlation, 100, 7) ==
+                                                std::vector<CurveScenario>(sample.begin(), sample.begin() + 100));
+
+    try {
+        VaREngine::simulateScenarios(vols, {{1.0, 1.5}, {1.5, 1.0}}, 10, 1);
+        fail("indefinite correlation accepted");
+    } catch (const std::invalid_argument&) {
+    }
+
+    // 4. Full revaluation P&L against repricing each bond on the shocked curve
+    YieldCurve curve = makeTestCurve();
+    std::vector<std::shared_ptr<Bond>> bonds = PortfolioGenerator(5).generatePortfolio(50);
+    PortfolioPricer portfolio(bonds);
+    std::vector<CurveScenario> scenarios(sample.begin(), sample.begin() + 20);
+    std::vector<double> pnl = VaREngine(ThreadPool::instance(), 3).scenarioPnL(portfolio, curve, scenarios);
+    for (std::size_t s = 0; s < scenarios.size(); ++s) {
+        YieldCurve shocked = curve;
+        shocked.shiftPillars(scenarios[s]);
+        double expected = 0.0;
+        for (const auto& bond : bonds) {
+            expected += bond->computeSensitivities(shocked).price - bond->computeSensitivities(curve).price;
+        }
+        expectNear("scenario " + std::to_string(s) + " P&L", pnl[s], expected, TOLERANCE);
+    }
+
+    return testResult("VaR, ES, scenario parsing and simulation are correct");
+}
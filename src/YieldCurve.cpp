@@ -1,41 +1,316 @@
 #include "YieldCurve.hpp"
+#include "VectorMath.hpp"
+#include <algorithm>
+#include <atomic>
 #include <cmath>
-#include <iterator>
+#include <stdexcept>
 
-void YieldCurve::addRate(double time, double rate) {
-    rates[time] = rate;
-}
+namespace {
+    // Upper bound on the bucket count, so a curve with one very short
+    // segment does not allocate a huge index.
+    constexpr std::size_t MAX_GRID_BUCKETS = 4096;
+
+    // out[i] = exp(-rate[i] * t[i]) in place over a contiguous block
+    void discountInPlace(const double* t, double* rateToDf, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            rateToDf[i] = -rateToDf[i] * t[i];
+        }
+        expInPlace(rateToDf, n);
+    }
 
-double YieldCurve::getRate(double t) const {
-    if (rates.empty())
+    // Twist shape at pillar i: +1 at the last pillar, -1 at the first,
+    // 0 at the pivot, linear in maturity on each side
+    double twistLoading(const std::vector<double>& times, std::size_t i, double pivot) {
+        if (times[i] > pivot) return (times[i] - pivot) / (times.back() - pivot);
+        if (times[i] < pivot) return -(pivot - times[i]) / (pivot - times.front());
         return 0.0;
+    }
 
-    // Lower bound renvoie le premier élément >= t
-    auto it = rates.lower_bound(t);
+    // Butterfly shape at pillar i: +1 at both wings, -1 at the belly
+    double butterflyLoading(const std::vector<double>& times, std::size_t i, double belly) {
+        double distance = 0.0; // 0 at the belly, 1 at the wing on that side
+        if (times[i] > belly) distance = (times[i] - belly) / (times.back() - belly);
+        else if (times[i] < belly) distance = (belly - times[i]) / (belly - times.front());
+        return 2.0 * distance - 1.0;
+    }
+}
 
-    if (it == rates.begin())
-        return it->second; // t <= premier point
-    if (it == rates.end())
-        return rates.rbegin()->second; // t >= dernier point
+std::uint64_t nextCurveVersion() {
+    static std::atomic<std::uint64_t> counter{0};
+    return ++counter;
+}
 
-    // Interpolation
-    double t2 = it->first;
-    double r2 = it->second;
-    auto prev = std::prev(it);
-    double t1 = prev->first;
-    double r1 = prev->second;
+template <class Interpolation>
+void BasicYieldCurve<Interpolation>::addRate(double time, double rate) {
+    // Keep the pillars sorted; overwrite if the maturity already exists
+    const std::vector<double>& times = grid->times;
+    auto it = std::lower_bound(times.begin(), times.end(), time);
+    std::size_t pos = static_cast<std::size_t>(it - times.begin());
 
-    return r1 + (r2 - r1) * ((t - t1) / (t2 - t1));
+    if (it != times.end() && *it == time) {
+        rates[pos] = rate;
+    } else {
+        // New maturity: copy-on-write, other curves keep the old grid
+        auto newGrid = std::make_shared<PillarGrid>(*grid);
+        newGrid->times.insert(newGrid->times.begin() + pos, time);
+        newGrid->rebuildIndex();
+        grid = std::move(newGrid);
+        rates.insert(rates.begin() + pos, rate);
+    }
+    rebuildSegments();
+    markReshaped();
 }
 
-double YieldCurve::getDiscountFactor(double t) const {
+template <class Interpolation>
+void BasicYieldCurve<Interpolation>::markReshaped() {
+    version = nextCurveVersion();
+    anchorVersion = version;
+    shiftFromAnchorBps = 0.0;
+}
+
+template <class Interpolation>
+void BasicYieldCurve<Interpolation>::rebuildSegments() {
+    const std::vector<double>& times = grid->times;
+    std::size_t count = times.size() > 1 ? times.size() - 1 : 0;
+    segments.resize(count);
+    Interpolation::build(times.data(), rates.data(), times.size(), 0, count, segments.data());
+}
+
+template <class Interpolation>
+void BasicYieldCurve<Interpolation>::rebuildSegmentsAround(std::size_t pillar) {
+    const std::vector<double>& times = grid->times;
+    std::size_t first = pillar > Interpolation::REACH ? pillar - Interpolation::REACH : 0;
+    std::size_t last = std::min(pillar + Interpolation::REACH, segments.size());
+    Interpolation::build(times.data(), rates.data(), times.size(), first, last, segments.data());
+}
+
+template <class Interpolation>
+void BasicYieldCurve<Interpolation>::PillarGrid::rebuildIndex() {
+    index.clear();
+    if (times.size() < 2) return;
+
+    // Bucket width no larger than the shortest segment, so a bucket spans at
+    // most one pillar and findSegment advances only a step or two.
+    double minWidth = times[1] - times[0];
+    for (std::size_t i = 2; i < times.size(); ++i) {
+        minWidth = std::min(minWidth, times[i] - times[i - 1]);
+    }
+
+    double span = times.back() - times.front();
+    std::size_t buckets = static_cast<std::size_t>(std::ceil(span / minWidth));
+    buckets = std::min(std::max<std::size_t>(buckets, 1), MAX_GRID_BUCKETS);
+
+    start = times.front();
+    scale = static_cast<double>(buckets) / span;
+
+    // One extra bucket absorbs rounding when t is just below the last pillar.
+    // bucketOf is monotonic in t, so a pillar in an earlier bucket than k is
+    // strictly below every t that lands in k.
+    index.resize(buckets + 1);
+    std::size_t seg = 0;
+    std::size_t lastSeg = times.size() - 2;
+    for (std::size_t k = 0; k <= buckets; ++k) {
+        while (seg < lastSeg && bucketOf(times[seg + 1]) < k) ++seg;
+        index[k] = seg;
+    }
+}
+
+template <class Interpolation>
+double BasicYieldCurve<Interpolation>::getRate(double t) const {
+    const std::vector<double>& times = grid->times;
+    if (times.empty())
+        return 0.0;
+
+    if (t <= times.front())
+        return rates.front(); // Flat before the first pillar
+    if (t >= times.back())
+        return rates.back(); // Flat after the last pillar
+
+    // Interpolation
+    std::size_t i = findSegment(t);
+    return rates[i] + Interpolation::offset(segments[i], t, t - times[i]);
+}
+
+template <class Interpolation>
+double BasicYieldCurve<Interpolation>::getDiscountFactor(double t) const {
     double r = getRate(t);
     return std::exp(-r * t);
 }
 
-void YieldCurve::parallelShift(double basisPoints) {
+template <class Interpolation>
+void BasicYieldCurve<Interpolation>::getRates(const double* t, double* out, std::size_t n) const {
+    const std::vector<double>& times = grid->times;
+    if (times.empty()) {
+        std::fill(out, out + n, 0.0);
+        return;
+    }
+
+    const double tFirst = times.front();
+    const double tLast = times.back();
+    std::size_t seg = 0;
+
+    for (std::size_t k = 0; k < n; ++k) {
+        double tk = t[k];
+        if (tk <= tFirst) {
+            out[k] = rates.front();
+        } else if (tk >= tLast) {
+            out[k] = rates.back();
+        } else {
+            // Carry the segment forward; only re-index when the input steps back
+            if (tk < times[seg]) seg = findSegment(tk);
+            while (tk >= times[seg + 1]) ++seg;
+            out[k] = rates[seg] + Interpolation::offset(segments[seg], tk, tk - times[seg]);
+        }
+    }
+}
+
+template <class Interpolation>
+void BasicYieldCurve<Interpolation>::getDiscountFactors(const double* t, double* out, std::size_t n) const {
+    // Pass 1: merged interpolation walk. Pass 2: branch-free exponentials.
+    getRates(t, out, n);
+    discountInPlace(t, out, n);
+}
+
+template <class Interpolation>
+void BasicYieldCurve<Interpolation>::getRatesAndDiscountFactors(const double* t, double* rateOut, double* dfOut,
+                                            std::size_t n) const {
+    getRates(t, rateOut, n);
+    std::copy(rateOut, rateOut + n, dfOut);
+    discountInPlace(t, dfOut, n);
+}
+
+template <class Interpolation>
+template <class, class>
+void BasicYieldCurve<Interpolation>::getPillarWeights(const double* t, std::size_t* left, double* w,
+                                                      std::size_t n) const {
+    const std::vector<double>& times = grid->times;
+    if (times.empty()) {
+        // No pillars: rates are zero and depend on nothing
+        std::fill(left, left + n, 0);
+        std::fill(w, w + n, 0.0);
+        return;
+    }
+
+    const double tFirst = times.front();
+    const double tLast = times.back();
+    std::size_t seg = 0;
+
+    for (std::size_t k = 0; k < n; ++k) {
+        double tk = t[k];
+        if (tk <= tFirst) {
+            left[k] = 0;
+            w[k] = 0.0;
+        } else if (tk >= tLast) {
+            left[k] = times.size() - 1;
+            w[k] = 0.0;
+        } else {
+            if (tk < times[seg]) seg = findSegment(tk);
+            while (tk >= times[seg + 1]) ++seg;
+            left[k] = seg;
+            w[k] = (tk - times[seg]) / (times[seg + 1] - times[seg]);
+        }
+    }
+}
+
+template <class Interpolation>
+void BasicYieldCurve<Interpolation>::parallelShift(double basisPoints) {
     double shift = basisPoints / 10000.0;
-    for (auto& pair : rates) {
-        pair.second += shift;
+    for (double& r : rates) {
+        r += shift;
+    }
+    // Segment coefficients are unchanged by a parallel move
+    version = nextCurveVersion();
+    shiftFromAnchorBps += basisPoints;
+}
+
+template <class Interpolation>
+void BasicYieldCurve<Interpolation>::bumpPillar(std::size_t index, double basisPoints) {
+    if (index >= rates.size()) {
+        throw std::out_of_range("YieldCurve::bumpPillar: no such pillar");
+    }
+    rates[index] += basisPoints / 10000.0;
+    rebuildSegmentsAround(index);
+    markReshaped();
+}
+
+template <class Interpolation>
+void BasicYieldCurve<Interpolation>::twist(double pivot, double basisPoints) {
+    const std::vector<double>& times = grid->times;
+    for (std::size_t i = 0; i < times.size(); ++i) {
+        rates[i] += basisPoints * twistLoading(times, i, pivot) / 10000.0;
+    }
+    rebuildSegments();
+    markReshaped();
+}
+
+template <class Interpolation>
+void BasicYieldCurve<Interpolation>::butterfly(double belly, double basisPoints) {
+    const std::vector<double>& times = grid->times;
+    for (std::size_t i = 0; i < times.size(); ++i) {
+        rates[i] += basisPoints * butterflyLoading(times, i, belly) / 10000.0;
+    }
+    rebuildSegments();
+    markReshaped();
+}
+
+template <class Interpolation>
+void BasicYieldCurve<Interpolation>::shiftPillars(const CurveScenario& basisPoints) {
+    if (basisPoints.size() != rates.size()) {
+        throw std::invalid_argument("YieldCurve::shiftPillars: expected one shift per pillar");
+    }
+    for (std::size_t i = 0; i < rates.size(); ++i) {
+        rates[i] += basisPoints[i] / 10000.0;
+    }
+    rebuildSegments();
+    markReshaped();
+}
+
+template <class Interpolation>
+void BasicYieldCurve<Interpolation>::setRates(const std::vector<double>& pillarRates) {
+    if (pillarRates.size() != rates.size()) {
+        throw std::invalid_argument("YieldCurve::setRates: expected one rate per pillar");
+    }
+    rates.assign(pillarRates.begin(), pillarRates.end());
+    rebuildSegments();
+    markReshaped();
+}
+
+template <class Interpolation>
+CurveScenario BasicYieldCurve<Interpolation>::twistShifts(double pivot, double basisPoints) const {
+    const std::vector<double>& times = grid->times;
+    CurveScenario shifts(times.size());
+    for (std::size_t i = 0; i < times.size(); ++i) {
+        shifts[i] = basisPoints * twistLoading(times, i, pivot);
     }
+    return shifts;
 }
+
+template <class Interpolation>
+CurveScenario BasicYieldCurve<Interpolation>::butterflyShifts(double belly, double basisPoints) const {
+    const std::vector<double>& times = grid->times;
+    CurveScenario shifts(times.size());
+    for (std::size_t i = 0; i < times.size(); ++i) {
+        shifts[i] = basisPoints * butterflyLoading(times, i, belly);
+    }
+    return shifts;
+}
+
+template <class Interpolation>
+void BasicYieldCurve<Interpolation>::assignShocked(const BasicYieldCurve& base, const CurveScenario& basisPoints) {
+    if (basisPoints.size() != base.rates.size()) {
+        throw std::invalid_argument("YieldCurve::assignShocked: expected one shift per pillar");
+    }
+    grid = base.grid;
+    rates.resize(base.rates.size());
+    for (std::size_t i = 0; i < rates.size(); ++i) {
+        rates[i] = base.rates[i] + basisPoints[i] / 10000.0;
+    }
+    rebuildSegments();
+    markReshaped();
+}
+
+template class BasicYieldCurve<LinearOnRate>;
+template class BasicYieldCurve<LogLinearOnDiscount>;
+template class BasicYieldCurve<MonotoneCubicOnRate>;
+
+template void YieldCurve::getPillarWeights(const double*, std::size_t*, double*, std::size_t) const;
@@ -0,0 +1,433 @@
+#include "TradingBook.hpp"
+#include "RiskEngine.hpp"
+#include "PortfolioGenerator.hpp"
+#include "QuoteEngine.hpp"
+#include "TradeIngestor.hpp"
+#include "Logger.hpp"
+#include "SpreadSolver.hpp"
+#include "CurveBootstrapper.hpp"
+#include <benchmark/benchmark.h>
+#include <random>
+#include <streambuf>
+#include <thread>
+
+// Pricing and risk benchmarks over seeded portfolios of 10 to 1M bonds.
+// Run through the `bench` target to write JSON results for regression tracking:
+//   cmake --build <build> --target bench   (writes <build>/bench_results.json)
+// or run PricingBenchmarks directly with the usual --benchmark_* flags.
+
+namespace
+{
+    constexpr unsigned SEED = 42;
+
+    template <class Curve = YieldCurve>
+    Curve makeCurve()
+    {
+        Curve curve;
+        curve.addRate(1.0, 0.03);
+        curve.addRate(5.0, 0.04);
+        curve.addRate(10.0, 0.05);
+        curve.addRate(30.0, 0.055);
+        return curve;
+    }
+
+    // First n bonds of one seeded universe, built by the bulk generator so
+    // the benchmarks run over its per-type contiguous storage. Every size is
+    // a prefix of the larger ones, so it is only regenerated for a bigger n.
+    const std::vector<std::shared_ptr<Bond>>& universe(std::size_t n)
+    {
+        static std::vector<std::shared_ptr<Bond>> bonds;
+        if (bonds.size() < n)
+        {
+            bonds = PortfolioGenerator(SEED).generatePortfolio(n);
+        }
+        return bonds;
+    }
+
+    // Swallows report output so the benchmarks time formatting, not the terminal
+    class NullBuffer : public std::streambuf
+    {
+    protected:
+        int overflow(int c) override { return c; }
+        std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+    };
+
+    class SilenceCout
+    {
+    private:
+        NullBuffer sink;
+        std::streambuf* saved;
+
+    public:
+        SilenceCout() : saved(std::cout.rdbuf(&sink)) {}
+        ~SilenceCout() { std::cout.rdbuf(saved); }
+    };
+
+    // A book holding a seeded position in each of the first n bonds (bond i
+    // has InstrumentId i), rebuilt only when the size changes
+    TradingBook& book(std::size_t n, const YieldCurve& curve)
+    {
+        static std::unique_ptr<TradingBook> cached;
+        static std::size_t cachedSize = 0;
+        if (!cached || cachedSize != n)
+        {
+            cached = std::make_unique<TradingBook>();
+            cachedSize = n;
+
+            std::mt19937 rng(SEED);
+            std::uniform_real_distribution<double> qtyDist(-500.0, 1000.0);
+            const auto& bonds = universe(n);
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                double price = bonds[i]->calculatePrice(curve);
+                InstrumentId id = cached->addKnownInstrument(bonds[i]); // == i
+                cached->bookTrade({id, qtyDist(rng), price}, price);
+            }
+        }
+        return *cached;
+    }
+
+    // Portfolio sizes 10, 100, ..., 1M
+    void portfolioSizes(benchmark::internal::Benchmark* b)
+    {
+        b->RangeMultiplier(10)->Range(10, 1000000)->Unit(benchmark::kMicrosecond);
+    }
+}
+
+// Building a universe into the contiguous per-type store
+static void BM_GenerateUniverse(benchmark::State& state)
+{
+    PortfolioGenerator gen(SEED);
+    for (auto _ : state)
+    {
+        InstrumentUniverse generated = gen.generateUniverse(static_cast<std::size_t>(state.range(0)));
+        benchmark::DoNotOptimize(generated.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GenerateUniverse)->Apply(portfolioSizes);
+
+// Intraday re-bootstrap on a quote tick: deposits to 1Y, then semi-annual
+// par bonds every year out to 30Y, into the same curve
+static void BM_BootstrapCurve(benchmark::State& state)
+{
+    std::vector<CurveInstrument> instruments = {CurveInstrument::deposit(0.25), CurveInstrument::deposit(0.5)};
+    std::vector<double> quotes = {0.030, 0.031};
+    for (int year = 1; year <= 30; ++year)
+    {
+        instruments.push_back(CurveInstrument::parBond(year, 2));
+        quotes.push_back(0.032 + 0.0008 * year);
+    }
+    CurveBootstrapper bootstrapper(instruments);
+    YieldCurve curve = bootstrapper.bootstrap(quotes);
+
+    double tick = 1e-6;
+    for (auto _ : state)
+    {
+        tick = -tick;
+        quotes[10] += tick;
+        bootstrapper.bootstrap(quotes, curve);
+        benchmark::DoNotOptimize(curve.getVersion());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * instruments.size()));
+}
+BENCHMARK(BM_BootstrapCurve)->Unit(benchmark::kMicrosecond);
+
+// Rate lookups at every cash flow date of the portfolio
+static void BM_GetRate(benchmark::State& state)
+{
+    const auto& bonds = universe(static_cast<std::size_t>(state.range(0)));
+    YieldCurve curve = makeCurve();
+    std::size_t lookups = 0;
+
+    for (auto _ : state)
+    {
+        double sum = 0.0;
+        lookups = 0;
+        for (std::size_t i = 0; i < static_cast<std::size_t>(state.range(0)); ++i)
+        {
+            for (double t : bonds[i]->getCashFlowTimes()) sum += curve.getRate(t);
+            lookups += bonds[i]->getCashFlowTimes().size();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * lookups));
+}
+BENCHMARK(BM_GetRate)->Apply(portfolioSizes);
+
+// Full reprice of every bond. The curve epoch advances each iteration so
+// the per-bond memo never serves a cached price.
+static void BM_CalculatePrice(benchmark::State& state)
+{
+    const auto& bonds = universe(static_cast<std::size_t>(state.range(0)));
+    YieldCurve curve = makeCurve();
+
+    for (auto _ : state)
+    {
+        curve.parallelShift(0.0);
+        double sum = 0.0;
+        for (std::size_t i = 0; i < static_cast<std::size_t>(state.range(0)); ++i)
+        {
+            sum += bonds[i]->calculatePrice(curve);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CalculatePrice)->Apply(portfolioSizes);
+
+// The same reprice over value-type instruments: no heap object or virtual
+// call per bond, and the coupon type is resolved by the visit
+static void BM_CalculatePriceVariant(benchmark::State& state)
+{
+    static std::vector<Instrument> instruments;
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    if (instruments.size() < n) instruments = PortfolioGenerator(SEED).generateInstruments(n);
+    YieldCurve curve = makeCurve();
+
+    for (auto _ : state)
+    {
+        double sum = 0.0;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            sum += computeSensitivities(instruments[i], curve).price;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CalculatePriceVariant)->Apply(portfolioSizes);
+
+// The full reprice under each interpolation policy
+template <class Curve>
+static void BM_CalculatePriceOn(benchmark::State& state)
+{
+    const auto& bonds = universe(static_cast<std::size_t>(state.range(0)));
+    Curve curve = makeCurve<Curve>();
+
+    for (auto _ : state)
+    {
+        curve.parallelShift(0.0);
+        double sum = 0.0;
+        for (std::size_t i = 0; i < static_cast<std::size_t>(state.range(0)); ++i)
+        {
+            sum += bonds[i]->calculatePrice(curve);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_CalculatePriceOn, LogLinearYieldCurve)->Apply(portfolioSizes);
+BENCHMARK_TEMPLATE(BM_CalculatePriceOn, MonotoneCubicYieldCurve)->Apply(portfolioSizes);
+
+static void BM_CalculatePV01(benchmark::State& state)
+{
+    const auto& bonds = universe(static_cast<std::size_t>(state.range(0)));
+    YieldCurve curve = makeCurve();
+
+    for (auto _ : state)
+    {
+        curve.parallelShift(0.0);
+        double sum = 0.0;
+        for (std::size_t i = 0; i < static_cast<std::size_t>(state.range(0)); ++i)
+        {
+            sum += RiskEngine::calculatePV01(*bonds[i], curve);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CalculatePV01)->Apply(portfolioSizes);
+
+// End-of-day Z-spreads for the whole universe, from prices 50bp over the curve
+static void BM_ZSpreadUniverse(benchmark::State& state)
+{
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    const auto& bonds = universe(n);
+    YieldCurve curve = makeCurve();
+    YieldCurve wide = curve;
+    wide.parallelShift(50.0);
+
+    std::vector<const Bond*> targets(n);
+    std::vector<double> prices(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        targets[i] = bonds[i].get();
+        prices[i] = bonds[i]->computeSensitivities(wide).price;
+    }
+
+    SpreadSolver solver;
+    std::vector<SpreadResult> spreads;
+    for (auto _ : state)
+    {
+        solver.zSpreads(targets, prices, curve, spreads);
+        benchmark::DoNotOptimize(spreads.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ZSpreadUniverse)->Apply(portfolioSizes);
+
+// Risk blotter after a 1bp market move: remark of every position plus the
+// formatted report (written to a null stream)
+static void BM_PrintRiskReport(benchmark::State& state)
+{
+    YieldCurve curve = makeCurve();
+    TradingBook& tradingBook = book(static_cast<std::size_t>(state.range(0)), curve);
+    SilenceCout quiet;
+    double shift = 1.0;
+
+    for (auto _ : state)
+    {
+        shift = -shift;
+        curve.parallelShift(shift);
+        tradingBook.printRiskReport(curve);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PrintRiskReport)->Apply(portfolioSizes);
+
+// One market-making tick as in the interactive simulator: curve move
+// (parallel and twist), quote an inventory-skewed price on a random bond,
+// book the client's fill and print the risk blotter
+static void BM_MarketMakingTick(benchmark::State& state)
+{
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    const auto& bonds = universe(n);
+    YieldCurve curve = makeCurve();
+    TradingBook& tradingBook = book(n, curve);
+    SilenceCout quiet;
+
+    std::mt19937 rng(SEED);
+    std::normal_distribution<double> shockDist(0.0, 5.0);
+    std::normal_distribution<double> sizeDist(500.0, 200.0);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::uniform_int_distribution<std::size_t> pick(0, n - 1);
+    const double baseSpread = 0.10;
+
+    for (auto _ : state)
+    {
+        // 1. Market move
+        curve.parallelShift(shockDist(rng));
+        curve.twist(10.0, shockDist(rng) * 0.5);
+
+        // 2. Quote a client
+        InstrumentId id = static_cast<InstrumentId>(pick(rng));
+        const Bond& bond = *bonds[id];
+        double mid = bond.calculatePrice(curve);
+        double pv01 = RiskEngine::calculatePV01(bond, curve);
+        Quote quote = tradingBook.getQuotedSpread(id, mid, pv01, baseSpread);
+
+        // 3. Fill and report
+        bool clientBuys = unit(rng) < 0.5;
+        double size = std::abs(sizeDist(rng));
+        double price = clientBuys ? quote.ask : quote.bid;
+        if (unit(rng) < std::exp(-std::abs(price - mid)))
+        {
+            tradingBook.bookTrade({id, clientBuys ? -size : size, price}, mid);
+        }
+        tradingBook.printRiskReport(curve);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MarketMakingTick)->Apply(portfolioSizes);
+
+// External string API: ticker -> InstrumentId -> position, for every line
+static void BM_PositionByTicker(benchmark::State& state)
+{
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    const auto& bonds = universe(n);
+    YieldCurve curve = makeCurve();
+    const TradingBook& tradingBook = book(n, curve);
+
+    for (auto _ : state)
+    {
+        double sum = 0.0;
+        for (std::size_t i = 0; i < n; ++i) sum += tradingBook.getPosition(bonds[i]->getTicker());
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PositionByTicker)->Apply(portfolioSizes);
+
+// One quote from precomputed state, the per-request cost on an unchanged curve
+static void BM_QuoteEngineQuote(benchmark::State& state)
+{
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    YieldCurve curve = makeCurve();
+    QuoteEngine quoter(book(n, curve), 0.10);
+    quoter.refresh(curve);
+
+    InstrumentId id = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(quoter.quote(id));
+        if (++id == n) id = 0;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_QuoteEngineQuote)->Apply(portfolioSizes)->Unit(benchmark::kNanosecond);
+
+// Curve move, quote state refresh and a quote for every instrument
+static void BM_QuoteUniverseTick(benchmark::State& state)
+{
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    YieldCurve curve = makeCurve();
+    QuoteEngine quoter(book(n, curve), 0.10);
+    std::vector<Quote> quotes(n);
+    double shift = 1.0;
+
+    for (auto _ : state)
+    {
+        shift = -shift;
+        curve.parallelShift(shift);
+        quoter.refresh(curve);
+        quoter.quoteAll(quotes.data());
+        benchmark::DoNotOptimize(quotes.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_QuoteUniverseTick)->Apply(portfolioSizes);
+
+// Fills per second through the lock-free queue and the book thread, with
+// range(0) feed threads submitting concurrently
+static void BM_TradeIngestion(benchmark::State& state)
+{
+    const std::size_t producers = static_cast<std::size_t>(state.range(0));
+    const std::size_t fillsPerProducer = 100000;
+    const std::size_t instruments = 1024;
+
+    TradingBook tradingBook;
+    for (const auto& bond : universe(instruments)) tradingBook.addKnownInstrument(bond);
+    TradeIngestor ingestor(tradingBook);
+
+    for (auto _ : state)
+    {
+        std::vector<std::thread> feeds;
+        for (std::size_t p = 0; p < producers; ++p)
+        {
+            feeds.emplace_back([&, p] {
+                for (std::size_t k = 0; k < fillsPerProducer; ++k)
+                {
+                    InstrumentId id = static_cast<InstrumentId>((p * 7919 + k) % instruments);
+                    double quantity = (k & 1) ? 100.0 : -100.0;
+                    ingestor.submit({id, quantity, 100.0}, 100.0);
+                }
+            });
+        }
+        for (auto& feed : feeds) feed.join();
+        ingestor.flush();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * producers * fillsPerProducer));
+}
+BENCHMARK(BM_TradeIngestion)->Arg(1)->Arg(2)->Arg(4)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Benchmark mode: trade and registration logging disabled at the source
+int main(int argc, char** argv)
+{
+    Logger::instance().setLevel(LogLevel::Off);
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -1,7 +1,12 @@
 #include "TradingBook.hpp"
-#include "PortfolioGenerator.cpp"
+#include "VaREngine.hpp"
+#include "QuoteEngine.hpp"
+#include "PortfolioGenerator.hpp"
+#include "Logger.hpp"
+#include "CurveBootstrapper.hpp"
 #include <thread>
 #include <chrono>
+#include <iomanip>
 #include <random>
 
 void applyRandomMarketMove(YieldCurve &curve, std::mt19937 &rng)
@@ -16,14 +21,12 @@ void applyRandomMarketMove(YieldCurve &curve, std::mt19937 &rng)
     // Short end moves differently than long end
     double slopeMove = shockDist(rng) * 0.5;
 
-    // Apply strictly parallel shift for now (simpler to implement in your current class)
-    // To do twists, your YieldCurve class needs a method 'addRate' that updates specific nodes.
-    // Let's stick to parallel for safety unless you expanded YieldCurve.
-
     curve.parallelShift(parallelMove);
+    curve.twist(10.0, slopeMove); // Pivot at the 10Y pillar
 
     std::cout << ">>> MARKET MOVED: " << (parallelMove > 0 ? "+" : "")
-              << parallelMove << " bps" << std::endl;
+              << parallelMove << " bps, twist " << (slopeMove > 0 ? "+" : "")
+              << slopeMove << " bps" << std::endl;
 }
 
 int main() {
@@ -36,25 +39,28 @@ int main() {
 
     // 2. Generate Random Inventory
     std::cout << "--- GENERATING INVENTORY ---" << std::endl;
-    PortfolioGenerator gen;
-    auto marketUniverse = gen.generatePortfolio(10); // Create 10 random bonds
+    PortfolioGenerator gen(std::random_device{}()); // Fresh universe every session
+    auto marketUniverse = gen.generateInstruments(10); // Create 10 random bonds
 
     TradingBook myBook;
-    // Register them all
-    for (const auto &bond : marketUniverse)
+    std::vector<InstrumentId> ids; // ids[i] is the i-th generated bond in the book
+    // Register them all (the book takes ownership)
+    for (auto &instrument : marketUniverse)
     {
-        myBook.addKnownInstrument(bond);
+        InstrumentId id = myBook.addKnownInstrument(std::move(instrument));
+        ids.push_back(id);
 
         // Initial Seed Trade: Buy some of everything to start with a portfolio
         // Random quantity between -500 (Short) and +1000 (Long)
         double qty = (rand() % 1500) - 500;
-        double price = bond->calculatePrice(curve); // Buying at "Mid" price
-        myBook.bookTrade({bond->getTicker(), qty, price}, price);
+        double price = myBook.getInstrument(id).calculatePrice(curve); // Buying at "Mid" price
+        myBook.bookTrade({id, qty, price}, price);
     }
 
     // Parameters
     double BASE_SPREAD = 0.10; // 10 cents
     std::mt19937 rng(std::random_device{}());
+    QuoteEngine quoter(myBook, BASE_SPREAD);
 
     // Random distributions
     // Trade size: Normal distribution centered at 500, sigma 200
@@ -63,6 +69,7 @@ int main() {
     std::uniform_int_distribution<int> sideDist(0, 1);
 
     // 3. Monte Carlo Simulation Loop
+    Logger::instance().flush(); // Registrations and seed trades first
     std::cout << "\n--- STARTING LIVE SIMULATION (Press Ctrl+C to stop) ---" << std::endl;
 
     for (int hour = 1; hour <= 10; ++hour)
@@ -72,15 +79,15 @@ int main() {
         applyRandomMarketMove(curve, rng);
 
         /// 1. Pick a random bond
-        auto bond = marketUniverse[rand() % marketUniverse.size()];
-        std::string ticker = bond->getTicker();
+        InstrumentId id = ids[rand() % ids.size()];
+        const std::string& ticker = myBook.getInstrument(id).getTicker();
 
-        // 2. Calculate Market Analytics
-        double midPrice = bond->calculatePrice(curve);
-        double unitPV01 = RiskEngine::calculatePV01(*bond, curve);
+        // 2. Market Analytics (repriced once per curve move, not per quote)
+        quoter.refresh(curve);
+        double midPrice = quoter.getState(id).mid;
 
         // 3. Get OUR Quotes (Inventory Aware)
-        Quote quote = myBook.getQuotedSpread(ticker, midPrice, unitPV01, BASE_SPREAD);
+        Quote quote = quoter.quote(id);
 
         // 4. Generate Random Client Order
         bool clientBuys = sideDist(rng) == 1; // 1 = Sell, 0 = Buy
@@ -104,7 +111,7 @@ int main() {
         if (hour % 1 == 0)
         {
             std::cout << "Ticker: " << ticker
-                      << " | Inv: " << myBook.getPosition(ticker)
+                      << " | Inv: " << myBook.getPosition(id)
                       << " | Mid: " << midPrice
                       << " | Skew: " << quote.skew
                       << " | Quote: " << quote.bid << " / " << quote.ask << std::endl;
@@ -120,7 +127,9 @@ int main() {
 
         if (std::uniform_real_distribution<>(0, 1)(rng) < probOfTrade)
         {
-            myBook.bookTrade({ticker, quantityForUs, executePrice}, midPrice);
+            Trade fill{id, quantityForUs, executePrice};
+            myBook.bookTrade(fill, midPrice);
+            quoter.onFill(fill);
 
             // 5. Print Report
             myBook.printRiskReport(curve);
@@ -134,5 +143,37 @@ int main() {
         }
     }
 
+    // 4. End of session curve risk by pillar
+    myBook.printKeyRateReport(curve);
+
+    // 5. Overnight 99% VaR / ES from correlated Monte Carlo pillar shocks
+    //    (daily vols in bps; correlation decays with the distance between pillars)
+    const std::vector<double>& pillars = curve.getPillarTimes();
+    std::vector<double> dailyVolsBps = {6.0, 7.0, 6.5, 5.5};
+    std::vector<std::vector<double>> correlation(pillars.size(), std::vector<double>(pillars.size()));
+    for (std::size_t i = 0; i < pillars.size(); ++i)
+        for (std::size_t j = 0; j < pillars.size(); ++j)
+            correlation[i][j] = std::exp(-std::abs(pillars[i] - pillars[j]) / 15.0);
+
+    auto scenarios = VaREngine::simulateScenarios(dailyVolsBps, correlation, 10000, 2024);
+    VaRResult var = VaREngine().compute(myBook, curve, scenarios, 0.99);
+    std::cout << "1-DAY 99% VaR: " << var.valueAtRisk
+              << " | Expected Shortfall: " << var.expectedShortfall
+              << " (" << scenarios.size() << " scenarios)" << std::endl;
+
+    // 6. Curve construction demo, separate from the session above: a zero
+    //    curve bootstrapped from sample end-of-day quotes (1Y deposit and
+    //    semi-annual par bonds), next to the session's closing curve
+    std::cout << "\n--- CURVE BOOTSTRAP (sample quotes) ---" << std::endl;
+    CurveBootstrapper bootstrapper({CurveInstrument::deposit(1.0), CurveInstrument::parBond(5.0, 2),
+                                    CurveInstrument::parBond(10.0, 2), CurveInstrument::parBond(30.0, 2)});
+    YieldCurve bootstrapped = bootstrapper.bootstrap({0.0305, 0.0405, 0.0495, 0.0535});
+    for (double t : bootstrapped.getPillarTimes())
+    {
+        std::cout << std::defaultfloat << t << "Y zero: "
+                  << std::fixed << std::setprecision(4) << bootstrapped.getRate(t) * 100.0 << "%"
+                  << " | session close: " << curve.getRate(t) * 100.0 << "%" << std::endl;
+    }
+
     return 0;
 }
\ No newline at end of file